@@ -0,0 +1,115 @@
+#include <SDL3/SDL.h>
+#include <box2d/box2d.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "CameraTransform.h"
+#include "Utils.h"
+
+// Micro-benchmark of world <-> screen conversion: the per-point Box2DToSDL /
+// SDLToBox2D helpers against CameraTransform's scalar and bulk (SIMD) paths.
+
+constexpr size_t POINT_COUNT = 1 << 16;
+constexpr int ITERATIONS = 200;
+constexpr float SCALE = 1.5F;
+constexpr float OFFSET_X = 12.5F;
+constexpr float OFFSET_Y = 9.25F;
+constexpr uint32_t WINDOW_WIDTH = 1920;
+constexpr uint32_t WINDOW_HEIGHT = 1080;
+
+namespace {
+
+volatile float sink = 0.0F;
+
+template <typename Fn>
+auto measureNanosecondsPerPoint(Fn&& fn) -> double {
+    fn();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(ITERATIONS) * POINT_COUNT);
+}
+
+void report(const std::string& name, double nsPerPoint, double baseline) {
+    std::cout << std::left << std::setw(34) << name
+              << std::right << std::fixed << std::setprecision(3) << std::setw(9) << nsPerPoint << " ns/point"
+              << std::setprecision(2) << std::setw(9) << (baseline / nsPerPoint) << "x" << std::endl;
+}
+
+} // namespace
+
+auto main() -> int {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-100.0F, 100.0F);
+
+    std::vector<b2Vec2> world(POINT_COUNT);
+    for (auto& p : world) {
+        p = b2Vec2{dist(rng), dist(rng)};
+    }
+    std::vector<SDL_FPoint> screen(POINT_COUNT);
+    std::vector<b2Vec2> roundTrip(POINT_COUNT);
+
+    const CameraTransform camera(SCALE, OFFSET_X, OFFSET_Y, WINDOW_WIDTH, WINDOW_HEIGHT);
+    std::cout << "CameraTransform SIMD path: " << CameraTransform::simdPath() << ", " << POINT_COUNT << " points x " << ITERATIONS << " iterations" << std::endl;
+
+    double legacyToScreen = measureNanosecondsPerPoint([&] {
+        for (size_t i = 0; i < POINT_COUNT; ++i) {
+            screen[i] = Box2DToSDL(world[i], SCALE, OFFSET_X, OFFSET_Y, WINDOW_WIDTH, WINDOW_HEIGHT);
+        }
+        sink = screen[POINT_COUNT / 2].x;
+    });
+    std::vector<SDL_FPoint> reference = screen;
+
+    double scalarToScreen = measureNanosecondsPerPoint([&] {
+        for (size_t i = 0; i < POINT_COUNT; ++i) {
+            screen[i] = camera.toScreen(world[i]);
+        }
+        sink = screen[POINT_COUNT / 2].x;
+    });
+
+    double bulkToScreen = measureNanosecondsPerPoint([&] {
+        camera.toScreen(world, screen);
+        sink = screen[POINT_COUNT / 2].x;
+    });
+
+    float maxScreenError = 0.0F;
+    for (size_t i = 0; i < POINT_COUNT; ++i) {
+        maxScreenError = std::max({maxScreenError, std::abs(screen[i].x - reference[i].x), std::abs(screen[i].y - reference[i].y)});
+    }
+
+    double legacyToWorld = measureNanosecondsPerPoint([&] {
+        for (size_t i = 0; i < POINT_COUNT; ++i) {
+            roundTrip[i] = SDLToBox2D(screen[i], SCALE, OFFSET_X, OFFSET_Y, WINDOW_WIDTH, WINDOW_HEIGHT);
+        }
+        sink = roundTrip[POINT_COUNT / 2].x;
+    });
+
+    double bulkToWorld = measureNanosecondsPerPoint([&] {
+        camera.toWorld(screen, roundTrip);
+        sink = roundTrip[POINT_COUNT / 2].x;
+    });
+
+    float maxWorldError = 0.0F;
+    for (size_t i = 0; i < POINT_COUNT; ++i) {
+        maxWorldError = std::max({maxWorldError, std::abs(roundTrip[i].x - world[i].x), std::abs(roundTrip[i].y - world[i].y)});
+    }
+
+    report("Box2DToSDL (per point)", legacyToScreen, legacyToScreen);
+    report("CameraTransform::toScreen", scalarToScreen, legacyToScreen);
+    report("CameraTransform::toScreen (bulk)", bulkToScreen, legacyToScreen);
+    report("SDLToBox2D (per point)", legacyToWorld, legacyToWorld);
+    report("CameraTransform::toWorld (bulk)", bulkToWorld, legacyToWorld);
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Max screen deviation from Box2DToSDL: " << maxScreenError << " px" << std::endl;
+    std::cout << "Max world round-trip error: " << maxWorldError << " m" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include <SDL3/SDL.h>
+#include <box2d/box2d.h>
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "AssetCache.h"
+#include "AssetFileSystem.h"
+#include "Character.h"
+#include "Determinism.h"
+#include "GameConfig.h"
+#include "Level.h"
+#include "WorldSnapshot.h"
+
+// Headless character controller benchmark: steps N characters on the level with
+// the dynamic (Box2D) and kinematic (tile grid) controllers under the same
+// scripted input, and reports the simulation cost per tick as JSON. Nothing is
+// rendered; the software renderer only exists to build the level. With
+// --deterministic the final state hash matches across builds.
+
+constexpr float GRAVITY_Y = -9.8F;
+constexpr float TIME_STEP = 1.0F / 60.0F;
+constexpr uint32_t WORLD_HEIGHT = 24;
+constexpr float CHARACTER_SPACING = 1.5F;
+constexpr int VIEW_WIDTH = 800;
+constexpr int VIEW_HEIGHT = 600;
+
+namespace {
+
+auto loadCharacterConfig(CharacterConfig& out) -> bool {
+    std::string contents;
+    std::string error;
+    if (!AssetFileSystem::readText(ConfigLoader::CHARACTER_CONFIG_PATH, contents)) {
+        spdlog::error("Failed to open {}", ConfigLoader::CHARACTER_CONFIG_PATH);
+        return false;
+    }
+    if (!ConfigLoader::parseCharacterConfig(contents, out, error)) {
+        spdlog::error("Invalid {}: {}", ConfigLoader::CHARACTER_CONFIG_PATH, error);
+        return false;
+    }
+    return true;
+}
+
+auto initVideo() -> bool {
+    for (const char* driver : {"offscreen", "dummy"}) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, driver);
+        if (SDL_Init(SDL_INIT_VIDEO)) {
+            return true;
+        }
+    }
+    spdlog::error("SDL_Init Error: {}", SDL_GetError());
+    return false;
+}
+
+auto percentile(std::vector<double> values, double p) -> double {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+// Each character walks back and forth and jumps on its own deterministic schedule
+void applyScriptedInput(Character& character, int index, int frame) {
+    const int phase = frame + (index * 7);
+    TickInput input;
+    input.held = TickInput::bit((phase / 120) % 2 == 0 ? InputButton::Right : InputButton::Left);
+    input.pressed = phase % 90 == 0 ? TickInput::bit(InputButton::Jump) : 0;
+    character.applyInput(input);
+}
+
+struct ControllerRun {
+    std::string name;
+    std::vector<double> tickTimes;
+    int groundedAtEnd = 0;
+    uint64_t finalHash = 0;
+};
+
+struct RunOptions {
+    int characterCount = 1000;
+    int frameCount = 600;
+    int warmupFrames = 60;
+    int subStepCount = 8;
+    bool deterministic = false;
+    std::ofstream* tickHashes = nullptr; // Optional per-tick hash CSV
+};
+
+auto runController(CharacterConfig characterConfig, CharacterController controller, SDL_Renderer* renderer,
+                   std::string& assetDir, const std::string& levelName, const RunOptions& options, ControllerRun& run) -> bool {
+    characterConfig.controller = controller;
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = b2Vec2{0.0F, GRAVITY_Y};
+    if (options.deterministic) {
+        Determinism::configureWorld(worldDef);
+    }
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+
+    bool succeeded = true;
+    {
+        AssetCache assets(renderer);
+        Level level(renderer, worldId, assetDir, VIEW_WIDTH, VIEW_HEIGHT, WORLD_HEIGHT);
+        std::string levelPath = assetDir + "/levels/" + levelName + ".tmj";
+        Character::requestAssets(characterConfig, assets);
+        if (!level.loadTilemap(levelPath, assets)) {
+            spdlog::error("Failed to load tilemap: {}", levelPath);
+            succeeded = false;
+        }
+
+        std::vector<std::unique_ptr<Character>> characters;
+        for (int i = 0; i < options.characterCount && succeeded; ++i) {
+            float x = 15.0F + (CHARACTER_SPACING * static_cast<float>(i % 32));
+            float y = 20.0F + (CHARACTER_SPACING * static_cast<float>(i / 32));
+            characters.push_back(std::make_unique<Character>(renderer, worldId, x, y, VIEW_WIDTH, VIEW_HEIGHT, characterConfig, assets));
+            characters.back()->setCollisionGrid(&level.getCollisionGrid());
+        }
+        assets.releaseSurfaces();
+
+        std::vector<b2BodyId> bodies;
+        std::vector<Character*> characterPointers;
+        for (auto& character : characters) {
+            bodies.push_back(character->getBodyId());
+            characterPointers.push_back(character.get());
+        }
+        WorldSnapshot state;
+
+        run.tickTimes.reserve(options.frameCount);
+        for (int frame = 0; frame < options.warmupFrames + options.frameCount && succeeded; ++frame) {
+            for (size_t i = 0; i < characters.size(); ++i) {
+                applyScriptedInput(*characters[i], static_cast<int>(i), frame);
+            }
+            auto start = std::chrono::steady_clock::now();
+            for (auto& character : characters) {
+                character->prepareStep(TIME_STEP);
+            }
+            b2World_Step(worldId, TIME_STEP, options.subStepCount);
+            for (auto& character : characters) {
+                character->update(TIME_STEP);
+            }
+            if (frame >= options.warmupFrames) {
+                run.tickTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+            if (options.tickHashes != nullptr || frame + 1 == options.warmupFrames + options.frameCount) {
+                state.capture(static_cast<uint64_t>(frame), bodies, characterPointers);
+                run.finalHash = Determinism::hash(state);
+                if (options.tickHashes != nullptr) {
+                    Determinism::writeCsvRow(*options.tickHashes, static_cast<uint64_t>(frame), run.finalHash);
+                }
+            }
+        }
+        run.groundedAtEnd = static_cast<int>(std::count_if(characters.begin(), characters.end(), [](const auto& character) { return character->isGrounded(); }));
+    }
+
+    b2DestroyWorld(worldId);
+    return succeeded;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    RunOptions runOptions;
+    std::string tickHashPath;
+    std::string controllerName = "both";
+    std::string assetDir = "assets";
+    std::string levelName = "test_level";
+
+    try {
+        cxxopts::Options options(argv[0], "Headless character controller benchmark");
+        options.add_options()
+            ("frames", "Number of measured ticks", cxxopts::value<int>(runOptions.frameCount)->default_value("600"))
+            ("characters", "Number of characters", cxxopts::value<int>(runOptions.characterCount)->default_value("1000"))
+            ("controller", "Controller to measure (dynamic, kinematic, both)", cxxopts::value<std::string>(controllerName)->default_value("both"))
+            ("a,assetDir", "Asset directory", cxxopts::value<std::string>(assetDir)->default_value("assets"))
+            ("l,levelName", "Level name", cxxopts::value<std::string>(levelName)->default_value("test_level"))
+            ("sub-steps", "Box2D sub-step count", cxxopts::value<int>(runOptions.subStepCount)->default_value("8"))
+            ("warmup-frames", "Ticks run before measuring", cxxopts::value<int>(runOptions.warmupFrames)->default_value("60"))
+            ("deterministic", "Single-threaded Box2D, as the game's --deterministic", cxxopts::value<bool>(runOptions.deterministic)->default_value("false"))
+            ("tick-hashes", "Write a state hash for every tick to this CSV file (one controller only)", cxxopts::value<std::string>(tickHashPath))
+            ("help", "Print help");
+
+        auto result = options.parse(argc, argv);
+        if (result.count("help") != 0U) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+    }
+    catch (const cxxopts::exceptions::exception& e) {
+        spdlog::error("Error parsing options: {}", e.what());
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, CharacterController>> controllers;
+    if (controllerName == "dynamic" || controllerName == "both") {
+        controllers.emplace_back("dynamic", CharacterController::Dynamic);
+    }
+    if (controllerName == "kinematic" || controllerName == "both") {
+        controllers.emplace_back("kinematic", CharacterController::Kinematic);
+    }
+    if (controllers.empty()) {
+        spdlog::error("Unknown controller '{}', expected dynamic, kinematic or both", controllerName);
+        return 1;
+    }
+
+    std::ofstream tickHashes;
+    if (!tickHashPath.empty()) {
+        if (controllers.size() != 1) {
+            spdlog::error("--tick-hashes needs --controller dynamic or kinematic");
+            return 1;
+        }
+        tickHashes.open(tickHashPath);
+        if (!tickHashes.is_open()) {
+            spdlog::error("Failed to open {}", tickHashPath);
+            return 1;
+        }
+        Determinism::writeCsvHeader(tickHashes);
+        runOptions.tickHashes = &tickHashes;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+
+    CharacterConfig characterConfig;
+    if (!loadCharacterConfig(characterConfig)) {
+        return 1;
+    }
+
+    if (!initVideo()) {
+        return 1;
+    }
+
+    SDL_Surface* target = SDL_CreateSurface(VIEW_WIDTH, VIEW_HEIGHT, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = target != nullptr ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr) {
+        spdlog::error("SDL_CreateSoftwareRenderer Error: {}", SDL_GetError());
+        SDL_DestroySurface(target);
+        SDL_Quit();
+        return 1;
+    }
+
+    int exitCode = 0;
+    nlohmann::json report;
+    report["characters"] = runOptions.characterCount;
+    report["frames"] = runOptions.frameCount;
+    report["subSteps"] = runOptions.subStepCount;
+    report["deterministic"] = runOptions.deterministic;
+    for (const auto& [name, controller] : controllers) {
+        ControllerRun run;
+        run.name = name;
+        if (!runController(characterConfig, controller, renderer, assetDir, levelName, runOptions, run)) {
+            exitCode = 1;
+            break;
+        }
+        double ticks = static_cast<double>(std::max<size_t>(run.tickTimes.size(), 1));
+        report["controllers"][name] = {
+            {"msPerTick", {
+                {"mean", std::accumulate(run.tickTimes.begin(), run.tickTimes.end(), 0.0) / ticks},
+                {"p50", percentile(run.tickTimes, 0.50)},
+                {"p95", percentile(run.tickTimes, 0.95)},
+                {"max", percentile(run.tickTimes, 1.0)}
+            }},
+            {"groundedAtEnd", run.groundedAtEnd},
+            {"finalStateHash", fmt::format("{:016x}", run.finalHash)}
+        };
+    }
+
+    if (exitCode == 0) {
+        std::cout << report.dump(4) << std::endl;
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return exitCode;
+}
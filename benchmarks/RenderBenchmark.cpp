@@ -0,0 +1,399 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <box2d/box2d.h>
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "AllocationTracker.h"
+#include "AssetCache.h"
+#include "AssetFileSystem.h"
+#include "Character.h"
+#include "GameConfig.h"
+#include "Level.h"
+#include "LowResRenderTarget.h"
+#include "PhysicsStats.h"
+#include "RenderStats.h"
+#include "Utils.h"
+
+// Headless render benchmark: renders the level and N characters through the
+// software renderer on SDL's offscreen/dummy video driver along a fixed
+// camera path, and reports frame cost and draw-call statistics as JSON.
+
+constexpr float GRAVITY_Y = -9.8F;
+constexpr float TIME_STEP = 1.0F / 60.0F;
+constexpr uint32_t WORLD_HEIGHT = 24;
+constexpr float CHARACTER_SPACING = 1.5F;
+
+namespace {
+
+auto loadCharacterConfig(CharacterConfig& out) -> bool {
+    std::string contents;
+    std::string error;
+    if (!AssetFileSystem::readText(ConfigLoader::CHARACTER_CONFIG_PATH, contents)) {
+        spdlog::error("Failed to open {}", ConfigLoader::CHARACTER_CONFIG_PATH);
+        return false;
+    }
+    if (!ConfigLoader::parseCharacterConfig(contents, out, error)) {
+        spdlog::error("Invalid {}: {}", ConfigLoader::CHARACTER_CONFIG_PATH, error);
+        return false;
+    }
+    return true;
+}
+
+// Deterministic camera centre for a given frame
+auto cameraCenter(const std::string& path, int frame, int frameCount, float baseX, float baseY) -> b2Vec2 {
+    float t = frameCount > 1 ? static_cast<float>(frame) / static_cast<float>(frameCount - 1) : 0.0F;
+    if (path == "pan") {
+        return b2Vec2{baseX + (t * 4.0F * baseX), baseY};
+    }
+    if (path == "orbit") {
+        float angle = t * 2.0F * b2_pi;
+        return b2Vec2{(2.0F * baseX) + (baseX * std::cos(angle)), baseY + (0.5F * baseY * std::sin(angle))};
+    }
+    return b2Vec2{baseX, baseY};
+}
+
+auto initVideo() -> bool {
+    for (const char* driver : {"offscreen", "dummy"}) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, driver);
+        if (SDL_Init(SDL_INIT_VIDEO)) {
+            spdlog::info("Using SDL video driver: {}", driver);
+            return true;
+        }
+    }
+    spdlog::error("SDL_Init Error: {}", SDL_GetError());
+    return false;
+}
+
+// Returns the number of differing pixels, or -1 when the images cannot be compared
+auto compareSurfaces(SDL_Surface* actual, SDL_Surface* expected) -> long {
+    SDL_Surface* a = SDL_ConvertSurface(actual, SDL_PIXELFORMAT_RGBA32);
+    SDL_Surface* b = SDL_ConvertSurface(expected, SDL_PIXELFORMAT_RGBA32);
+    long diff = -1;
+    if (a != nullptr && b != nullptr && a->w == b->w && a->h == b->h) {
+        diff = 0;
+        for (int y = 0; y < a->h; ++y) {
+            const auto* rowA = static_cast<const uint32_t*>(a->pixels) + (static_cast<ptrdiff_t>(y) * a->pitch / 4);
+            const auto* rowB = static_cast<const uint32_t*>(b->pixels) + (static_cast<ptrdiff_t>(y) * b->pitch / 4);
+            for (int x = 0; x < a->w; ++x) {
+                diff += rowA[x] != rowB[x] ? 1 : 0;
+            }
+        }
+    }
+    SDL_DestroySurface(a);
+    SDL_DestroySurface(b);
+    return diff;
+}
+
+auto percentile(std::vector<double> values, double p) -> double {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    int width = 800;
+    int height = 600;
+    int frameCount = 300;
+    int characterCount = 1;
+    int goldenInterval = 60;
+    int subStepCount = 8;
+    int warmupFrames = 60;
+    long allocationBudget = -1;
+    std::string cameraPath = "pan";
+    std::string assetDir = "assets";
+    std::string levelName = "test_level";
+    std::string outputPath;
+    std::string goldenDir;
+    std::string compareDir;
+    std::string lowResolution;
+    std::string physicsLogPath;
+    std::string packPath;
+
+    try {
+        cxxopts::Options options(argv[0], "Headless render benchmark");
+        options.add_options()
+            ("w,width", "Render width", cxxopts::value<int>(width)->default_value("800"))
+            ("h,height", "Render height", cxxopts::value<int>(height)->default_value("600"))
+            ("frames", "Number of frames to render", cxxopts::value<int>(frameCount)->default_value("300"))
+            ("characters", "Number of characters", cxxopts::value<int>(characterCount)->default_value("1"))
+            ("camera", "Camera path (static, pan, orbit)", cxxopts::value<std::string>(cameraPath)->default_value("pan"))
+            ("a,assetDir", "Asset directory", cxxopts::value<std::string>(assetDir)->default_value("assets"))
+            ("l,levelName", "Level name", cxxopts::value<std::string>(levelName)->default_value("test_level"))
+            ("o,output", "Write the JSON report to this file instead of stdout", cxxopts::value<std::string>(outputPath))
+            ("pack", "Mount this asset pack before loading", cxxopts::value<std::string>(packPath))
+            ("golden-dir", "Dump PNG frames to this directory", cxxopts::value<std::string>(goldenDir))
+            ("compare-dir", "Compare frames against PNGs in this directory", cxxopts::value<std::string>(compareDir))
+            ("low-res", "Render the world into a fixed WIDTHxHEIGHT target and upscale it", cxxopts::value<std::string>(lowResolution))
+            ("golden-interval", "Frames between golden images", cxxopts::value<int>(goldenInterval)->default_value("60"))
+            ("sub-steps", "Box2D sub-step count", cxxopts::value<int>(subStepCount)->default_value("8"))
+            ("physics-log", "Write Box2D profile and counters for every step to this CSV file", cxxopts::value<std::string>(physicsLogPath))
+            ("alloc-budget", "Fail (exit code 3) if any frame after the warm-up allocates more than this many times", cxxopts::value<long>(allocationBudget))
+            ("warmup-frames", "Frames excluded from the allocation budget", cxxopts::value<int>(warmupFrames)->default_value("60"))
+            ("help", "Print help");
+
+        auto result = options.parse(argc, argv);
+        if (result.count("help") != 0U) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+    }
+    catch (const cxxopts::exceptions::exception& e) {
+        spdlog::error("Error parsing options: {}", e.what());
+        return 1;
+    }
+
+    AllocationTracker::installSdlAllocator();
+    spdlog::set_level(spdlog::level::warn);
+
+    if (allocationBudget >= 0 && !AllocationTracker::isEnabled()) {
+        spdlog::error("--alloc-budget needs a build configured with -DTRACK_ALLOCATIONS=ON");
+        return 1;
+    }
+
+    if (!packPath.empty() && !AssetFileSystem::mountPack(packPath)) {
+        return 1;
+    }
+
+    CharacterConfig characterConfig;
+    if (!loadCharacterConfig(characterConfig)) {
+        return 1;
+    }
+
+    if (!initVideo()) {
+        return 1;
+    }
+
+    SDL_Surface* target = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = target != nullptr ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr) {
+        spdlog::error("SDL_CreateSoftwareRenderer Error: {}", SDL_GetError());
+        SDL_DestroySurface(target);
+        SDL_Quit();
+        return 1;
+    }
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = b2Vec2{0.0F, GRAVITY_Y};
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+
+    int exitCode = 0;
+    nlohmann::json report;
+    {
+        int viewWidth = width;
+        int viewHeight = height;
+        std::unique_ptr<LowResRenderTarget> lowResTarget;
+        if (!lowResolution.empty()) {
+            if (!LowResRenderTarget::parseResolution(lowResolution, viewWidth, viewHeight)) {
+                spdlog::error("Invalid low resolution '{}', expected WIDTHxHEIGHT", lowResolution);
+                exitCode = 1;
+            } else {
+                lowResTarget = std::make_unique<LowResRenderTarget>(renderer, viewWidth, viewHeight);
+                if (!lowResTarget->isValid()) {
+                    exitCode = 1;
+                }
+            }
+        }
+
+        AssetCache assets(renderer);
+        Level level(renderer, worldId, assetDir, viewWidth, viewHeight, WORLD_HEIGHT);
+        std::string levelPath = assetDir + "/levels/" + levelName + ".tmj";
+        Character::requestAssets(characterConfig, assets);
+        if (!level.loadTilemap(levelPath, assets)) {
+            spdlog::error("Failed to load tilemap: {}", levelPath);
+            exitCode = 1;
+        }
+
+        std::vector<std::unique_ptr<Character>> characters;
+        for (int i = 0; i < characterCount && exitCode == 0; ++i) {
+            float x = 15.0F + (CHARACTER_SPACING * static_cast<float>(i % 32));
+            float y = 20.0F + (CHARACTER_SPACING * static_cast<float>(i / 32));
+            characters.push_back(std::make_unique<Character>(renderer, worldId, x, y, viewWidth, viewHeight, characterConfig, assets));
+        }
+        assets.releaseSurfaces();
+
+        if (!goldenDir.empty()) {
+            std::filesystem::create_directories(goldenDir);
+        }
+
+        PhysicsStats physicsStats;
+        physicsStats.setSceneInfo(subStepCount, level.getStaticChainVertexCount());
+        std::ofstream physicsLog;
+        if (!physicsLogPath.empty()) {
+            physicsLog.open(physicsLogPath);
+            if (!physicsLog.is_open()) {
+                spdlog::error("Failed to open physics log: {}", physicsLogPath);
+                exitCode = 1;
+            }
+            PhysicsStats::writeCsvHeader(physicsLog);
+        }
+        std::vector<double> physicsTotals(PhysicsStats::getTimingMetrics().size() + PhysicsStats::getCounterMetrics().size(), 0.0);
+
+        const float baseX = viewWidth / (2.0F * PIXELS_PER_METER);
+        const float baseY = viewHeight / (2.0F * PIXELS_PER_METER);
+        std::vector<double> frameTimes;
+        frameTimes.reserve(frameCount);
+        RenderCounters totals;
+        long mismatchedFrames = 0;
+        uint64_t steadyAllocations = 0;
+        uint64_t steadyAllocatedBytes = 0;
+        uint64_t peakFrameAllocations = 0;
+        int steadyFrames = 0;
+
+        for (int frame = 0; frame < frameCount && exitCode == 0; ++frame) {
+            const AllocationCounters allocationsAtStart = AllocationTracker::getTotals();
+            b2World_Step(worldId, TIME_STEP, subStepCount);
+            physicsStats.record(worldId);
+            if (physicsLog.is_open()) {
+                physicsStats.writeCsvRow(physicsLog);
+            }
+            size_t metricIndex = 0;
+            for (const auto& metrics : {PhysicsStats::getTimingMetrics(), PhysicsStats::getCounterMetrics()}) {
+                for (const auto& metric : metrics) {
+                    physicsTotals[metricIndex++] += metric.value(physicsStats.getSample(0));
+                }
+            }
+            for (auto& character : characters) {
+                character->checkGroundContact();
+                character->update(TIME_STEP);
+            }
+
+            b2Vec2 center = cameraCenter(cameraPath, frame, frameCount, baseX, baseY);
+            level.setViewportCenter(center.x, center.y);
+
+            RenderStats::reset();
+            auto start = std::chrono::steady_clock::now();
+
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            if (lowResTarget) {
+                lowResTarget->begin();
+            }
+            const CameraTransform camera = level.getCamera();
+            level.render();
+            for (auto& character : characters) {
+                character->render(camera);
+            }
+            if (lowResTarget) {
+                lowResTarget->end();
+            }
+            SDL_RenderPresent(renderer);
+
+            frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            const RenderCounters& counters = RenderStats::getCounters();
+            totals.drawCalls += counters.drawCalls;
+            totals.textureSwitches += counters.textureSwitches;
+            totals.vertices += counters.vertices;
+
+            // Golden image I/O below is not part of the frame
+            if (frame >= warmupFrames) {
+                const AllocationCounters frameAllocations = AllocationTracker::getTotals() - allocationsAtStart;
+                steadyAllocations += frameAllocations.allocations;
+                steadyAllocatedBytes += frameAllocations.bytes;
+                peakFrameAllocations = std::max(peakFrameAllocations, frameAllocations.allocations);
+                steadyFrames++;
+            }
+
+            bool captureFrame = goldenInterval > 0 && frame % goldenInterval == 0;
+            if (captureFrame && (!goldenDir.empty() || !compareDir.empty())) {
+                std::string fileName = "frame_" + std::to_string(frame) + ".png";
+                if (!goldenDir.empty() && !IMG_SavePNG(target, (goldenDir + "/" + fileName).c_str())) {
+                    spdlog::error("Failed to write golden image {}: {}", fileName, SDL_GetError());
+                }
+                if (!compareDir.empty()) {
+                    std::string expectedPath = compareDir + "/" + fileName;
+                    SDL_Surface* expected = IMG_Load(expectedPath.c_str());
+                    long diff = expected != nullptr ? compareSurfaces(target, expected) : -1;
+                    SDL_DestroySurface(expected);
+                    if (diff != 0) {
+                        spdlog::error("Frame {} differs from {} ({} pixels)", frame, expectedPath, diff);
+                        mismatchedFrames++;
+                    }
+                }
+            }
+        }
+
+        if (exitCode == 0) {
+            double frames = static_cast<double>(std::max<size_t>(frameTimes.size(), 1));
+            report["renderer"] = "software";
+            report["width"] = width;
+            report["height"] = height;
+            report["frames"] = frameTimes.size();
+            report["characters"] = characterCount;
+            report["cameraPath"] = cameraPath;
+            report["lowResolution"] = lowResolution;
+            report["msPerFrame"] = {
+                {"mean", std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frames},
+                {"p50", percentile(frameTimes, 0.50)},
+                {"p95", percentile(frameTimes, 0.95)},
+                {"max", percentile(frameTimes, 1.0)}
+            };
+            report["perFrame"] = {
+                {"drawCalls", static_cast<double>(totals.drawCalls) / frames},
+                {"textureSwitches", static_cast<double>(totals.textureSwitches) / frames},
+                {"vertices", static_cast<double>(totals.vertices) / frames}
+            };
+            report["totals"] = {
+                {"drawCalls", totals.drawCalls},
+                {"textureSwitches", totals.textureSwitches},
+                {"vertices", totals.vertices}
+            };
+            report["subSteps"] = subStepCount;
+            report["chainVertices"] = level.getStaticChainVertexCount();
+            size_t metricIndex = 0;
+            for (const auto& [group, metrics] : {std::pair{"physicsMsPerStep", PhysicsStats::getTimingMetrics()},
+                                                 std::pair{"physicsCountersPerStep", PhysicsStats::getCounterMetrics()}}) {
+                for (const auto& metric : metrics) {
+                    report[group][metric.name] = physicsTotals[metricIndex++] / frames;
+                }
+            }
+            if (AllocationTracker::isEnabled()) {
+                double steady = static_cast<double>(std::max(steadyFrames, 1));
+                report["allocationsPerFrame"] = {
+                    {"warmupFrames", warmupFrames},
+                    {"mean", static_cast<double>(steadyAllocations) / steady},
+                    {"max", peakFrameAllocations},
+                    {"bytesMean", static_cast<double>(steadyAllocatedBytes) / steady}
+                };
+                if (allocationBudget >= 0 && peakFrameAllocations > static_cast<uint64_t>(allocationBudget)) {
+                    spdlog::error("Steady-state frame allocated {} times, budget is {}", peakFrameAllocations, allocationBudget);
+                    exitCode = 3;
+                }
+            }
+            if (!compareDir.empty()) {
+                report["mismatchedFrames"] = mismatchedFrames;
+                if (mismatchedFrames > 0 && exitCode == 0) {
+                    exitCode = 2;
+                }
+            }
+        }
+    }
+
+    if (!report.is_null()) {
+        if (outputPath.empty()) {
+            std::cout << report.dump(4) << std::endl;
+        } else {
+            std::ofstream outputFile(outputPath);
+            outputFile << report.dump(4) << std::endl;
+        }
+    }
+
+    b2DestroyWorld(worldId);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return exitCode;
+}
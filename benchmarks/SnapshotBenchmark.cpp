@@ -0,0 +1,165 @@
+#include <box2d/box2d.h>
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "WorldSnapshot.h"
+
+// Snapshot benchmark: drops N dynamic boxes into a pile, captures a
+// WorldSnapshot into a SnapshotHistory every tick and periodically rewinds a
+// second, reporting capture and restore cost as JSON. Every restore is
+// captured again and compared with the snapshot it came from.
+
+constexpr float GRAVITY_Y = -9.8F;
+constexpr float TIME_STEP = 1.0F / 60.0F;
+constexpr int BOXES_PER_ROW = 100;
+
+namespace {
+
+auto percentile(std::vector<double> values, double p) -> double {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+auto summarize(const std::vector<double>& values) -> nlohmann::json {
+    double count = static_cast<double>(std::max<size_t>(values.size(), 1));
+    return {
+        {"mean", std::accumulate(values.begin(), values.end(), 0.0) / count},
+        {"p50", percentile(values, 0.50)},
+        {"p95", percentile(values, 0.95)},
+        {"max", percentile(values, 1.0)}
+    };
+}
+
+auto sameBodies(const WorldSnapshot& a, const WorldSnapshot& b) -> bool {
+    return std::equal(a.bodies.begin(), a.bodies.end(), b.bodies.begin(), b.bodies.end(), [](const BodySnapshot& x, const BodySnapshot& y) {
+        return x.transform.p.x == y.transform.p.x && x.transform.p.y == y.transform.p.y &&
+               x.transform.q.c == y.transform.q.c && x.transform.q.s == y.transform.q.s &&
+               x.linearVelocity.x == y.linearVelocity.x && x.linearVelocity.y == y.linearVelocity.y &&
+               x.angularVelocity == y.angularVelocity && x.awake == y.awake;
+    });
+}
+
+auto millisecondsSince(std::chrono::steady_clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    int bodyCount = 4000;
+    int frameCount = 600;
+    int rewindInterval = 120;
+    int rewindTicks = 60;
+    int subStepCount = 8;
+    double budgetMs = 1.0;
+
+    try {
+        cxxopts::Options options(argv[0], "World snapshot capture and restore benchmark");
+        options.add_options()
+            ("bodies", "Number of dynamic bodies", cxxopts::value<int>(bodyCount)->default_value("4000"))
+            ("frames", "Number of simulated ticks", cxxopts::value<int>(frameCount)->default_value("600"))
+            ("rewind-interval", "Ticks between rewinds", cxxopts::value<int>(rewindInterval)->default_value("120"))
+            ("rewind-ticks", "How far each rewind goes back", cxxopts::value<int>(rewindTicks)->default_value("60"))
+            ("sub-steps", "Box2D sub-step count", cxxopts::value<int>(subStepCount)->default_value("8"))
+            ("budget-ms", "Fail (exit code 3) if p95 capture or restore takes longer", cxxopts::value<double>(budgetMs)->default_value("1.0"))
+            ("help", "Print help");
+
+        auto result = options.parse(argc, argv);
+        if (result.count("help") != 0U) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+    }
+    catch (const cxxopts::exceptions::exception& e) {
+        spdlog::error("Error parsing options: {}", e.what());
+        return 1;
+    }
+
+    if (rewindTicks <= 0 || static_cast<size_t>(rewindTicks) >= SnapshotHistory::CAPACITY) {
+        spdlog::error("--rewind-ticks must be between 1 and {}", SnapshotHistory::CAPACITY - 1);
+        return 1;
+    }
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = b2Vec2{0.0F, GRAVITY_Y};
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+
+    b2BodyDef groundDef = b2DefaultBodyDef();
+    b2BodyId ground = b2CreateBody(worldId, &groundDef);
+    b2ShapeDef groundShape = b2DefaultShapeDef();
+    b2Polygon groundBox = b2MakeBox(BOXES_PER_ROW, 1.0F);
+    b2CreatePolygonShape(ground, &groundShape, &groundBox);
+
+    std::vector<b2BodyId> bodies;
+    bodies.reserve(bodyCount);
+    b2Polygon box = b2MakeBox(0.4F, 0.4F);
+    for (int i = 0; i < bodyCount; ++i) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = b2Vec2{static_cast<float>((i % BOXES_PER_ROW) - (BOXES_PER_ROW / 2)), 2.0F + static_cast<float>(i / BOXES_PER_ROW)};
+        b2BodyId body = b2CreateBody(worldId, &bodyDef);
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        b2CreatePolygonShape(body, &shapeDef, &box);
+        bodies.push_back(body);
+    }
+
+    SnapshotHistory history;
+    WorldSnapshot check;
+    std::vector<double> captureTimes;
+    std::vector<double> restoreTimes;
+    captureTimes.reserve(frameCount);
+    long mismatchedRestores = 0;
+    uint64_t tick = 0;
+    history.capture(tick, bodies, {});
+
+    for (int frame = 1; frame <= frameCount; ++frame) {
+        b2World_Step(worldId, TIME_STEP, subStepCount);
+        tick++;
+        auto start = std::chrono::steady_clock::now();
+        history.capture(tick, bodies, {});
+        captureTimes.push_back(millisecondsSince(start));
+
+        if (rewindInterval > 0 && frame % rewindInterval == 0 && tick > static_cast<uint64_t>(rewindTicks)) {
+            const uint64_t target = tick - rewindTicks;
+            start = std::chrono::steady_clock::now();
+            const bool restored = history.rewindTo(target, bodies, {});
+            restoreTimes.push_back(millisecondsSince(start));
+            check.capture(target, bodies, {});
+            if (!restored || !sameBodies(check, *history.find(target))) {
+                spdlog::error("Restoring tick {} did not reproduce its snapshot", target);
+                mismatchedRestores++;
+            }
+            tick = target;
+        }
+    }
+
+    nlohmann::json report;
+    report["bodies"] = bodyCount;
+    report["frames"] = frameCount;
+    report["historyCapacity"] = SnapshotHistory::CAPACITY;
+    report["snapshotBytes"] = bodyCount * sizeof(BodySnapshot);
+    report["captureMs"] = summarize(captureTimes);
+    report["restoreMs"] = summarize(restoreTimes);
+    report["restores"] = restoreTimes.size();
+    report["mismatchedRestores"] = mismatchedRestores;
+    std::cout << report.dump(4) << std::endl;
+
+    b2DestroyWorld(worldId);
+
+    if (mismatchedRestores > 0) {
+        return 2;
+    }
+    if (percentile(captureTimes, 0.95) > budgetMs || percentile(restoreTimes, 0.95) > budgetMs) {
+        spdlog::error("Snapshot p95 exceeds the {:.2f} ms budget", budgetMs);
+        return 3;
+    }
+    return 0;
+}
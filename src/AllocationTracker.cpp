@@ -0,0 +1,162 @@
+#include "AllocationTracker.h"
+
+#ifdef PLATFORMER_TRACK_ALLOCATIONS
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+std::atomic<uint64_t> totalAllocations{0};
+std::atomic<uint64_t> totalFrees{0};
+std::atomic<uint64_t> totalBytes{0};
+
+thread_local AllocationCounters threadCounters;
+
+SDL_malloc_func originalMalloc = nullptr;
+SDL_calloc_func originalCalloc = nullptr;
+SDL_realloc_func originalRealloc = nullptr;
+SDL_free_func originalFree = nullptr;
+
+auto countingMalloc(size_t size) -> void* {
+    AllocationTracker::recordAllocation(size);
+    return originalMalloc(size);
+}
+
+auto countingCalloc(size_t count, size_t size) -> void* {
+    AllocationTracker::recordAllocation(count * size);
+    return originalCalloc(count, size);
+}
+
+// A realloc of an existing block is counted as a free plus a new allocation
+auto countingRealloc(void* memory, size_t size) -> void* {
+    if (memory != nullptr) {
+        AllocationTracker::recordFree();
+    }
+    AllocationTracker::recordAllocation(size);
+    return originalRealloc(memory, size);
+}
+
+void countingFree(void* memory) {
+    if (memory != nullptr) {
+        AllocationTracker::recordFree();
+    }
+    originalFree(memory);
+}
+
+auto allocate(std::size_t size) -> void* {
+    AllocationTracker::recordAllocation(size);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+auto allocateAligned(std::size_t size, std::align_val_t alignment) -> void* {
+    AllocationTracker::recordAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    void* memory = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    void* memory = std::aligned_alloc(align, ((size + align - 1) / align) * align);
+#endif
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void release(void* memory) noexcept {
+    if (memory != nullptr) {
+        AllocationTracker::recordFree();
+        std::free(memory);
+    }
+}
+
+void releaseAligned(void* memory) noexcept {
+    if (memory != nullptr) {
+        AllocationTracker::recordFree();
+#ifdef _MSC_VER
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+} // namespace
+
+void AllocationTracker::installSdlAllocator() {
+    SDL_GetOriginalMemoryFunctions(&originalMalloc, &originalCalloc, &originalRealloc, &originalFree);
+    if (!SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc, countingFree)) {
+        spdlog::error("SDL_SetMemoryFunctions Error: {}", SDL_GetError());
+    }
+}
+
+auto AllocationTracker::getTotals() -> AllocationCounters {
+    return AllocationCounters{totalAllocations.load(std::memory_order_relaxed), totalFrees.load(std::memory_order_relaxed),
+                              totalBytes.load(std::memory_order_relaxed)};
+}
+
+auto AllocationTracker::getThreadTotals() -> AllocationCounters {
+    return threadCounters;
+}
+
+void AllocationTracker::recordAllocation(uint64_t bytes) {
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    threadCounters.allocations++;
+    threadCounters.bytes += bytes;
+}
+
+void AllocationTracker::recordFree() {
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+    threadCounters.frees++;
+}
+
+// Array, nothrow and sized forms forward to these in the standard library
+auto operator new(std::size_t size) -> void* {
+    return allocate(size);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    release(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    release(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    releaseAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    releaseAligned(memory);
+}
+
+#else
+
+void AllocationTracker::installSdlAllocator() {}
+
+auto AllocationTracker::getTotals() -> AllocationCounters {
+    return AllocationCounters{};
+}
+
+auto AllocationTracker::getThreadTotals() -> AllocationCounters {
+    return AllocationCounters{};
+}
+
+void AllocationTracker::recordAllocation(uint64_t) {}
+
+void AllocationTracker::recordFree() {}
+
+#endif
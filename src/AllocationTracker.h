@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0; // Requested bytes; frees are not subtracted
+};
+
+inline auto operator-(const AllocationCounters& a, const AllocationCounters& b) -> AllocationCounters {
+    return AllocationCounters{a.allocations - b.allocations, a.frees - b.frees, a.bytes - b.bytes};
+}
+
+// Opt-in heap accounting. With PLATFORMER_TRACK_ALLOCATIONS defined (CMake
+// option TRACK_ALLOCATIONS), global operator new/delete are replaced and SDL
+// is routed through counting allocator functions; without it every counter
+// stays zero and nothing is hooked. Per-frame and per-zone figures are
+// differences between two snapshots.
+class AllocationTracker {
+public:
+    [[nodiscard]] static constexpr auto isEnabled() -> bool {
+#ifdef PLATFORMER_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Must run before SDL_Init so every SDL allocation goes through the counting functions
+    static void installSdlAllocator();
+
+    // Process-wide totals
+    [[nodiscard]] static auto getTotals() -> AllocationCounters;
+    // Totals for the calling thread, used for profiler zones
+    [[nodiscard]] static auto getThreadTotals() -> AllocationCounters;
+
+    static void recordAllocation(uint64_t bytes);
+    static void recordFree();
+};
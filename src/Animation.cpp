@@ -1,4 +1,5 @@
 #include "Animation.h"
+#include <algorithm>
 
 Animation::Animation() : currentFrameIndex(0), currentTime(0.0F), flip(SDL_FLIP_NONE), isLooping(true), isCompleted(false) {}
 
@@ -9,9 +10,19 @@ Animation::~Animation() {
 }
 
 void Animation::addFrame(SDL_Texture* texture, int duration) {
+    // Pixel art frames are scaled up at draw time, keep them crisp
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
     frames.push_back({texture, duration});
 }
 
+void Animation::clearFrames() {
+    for (auto& frame : frames) {
+        SDL_DestroyTexture(frame.texture);
+    }
+    frames.clear();
+    reset();
+}
+
 void Animation::update(float deltaTime) {
     if (frames.empty()) { return; }
 
@@ -73,3 +84,13 @@ auto Animation::getTotalFrames() const -> int {
 bool Animation::hasCompleted() const {
     return isCompleted;
 }
+
+auto Animation::getPlayback() const -> AnimationPlayback {
+    return {currentFrameIndex, currentTime, isCompleted};
+}
+
+void Animation::setPlayback(const AnimationPlayback& playback) {
+    currentFrameIndex = frames.empty() ? 0 : std::clamp(playback.frameIndex, 0, static_cast<int>(frames.size()) - 1);
+    currentTime = playback.time;
+    isCompleted = playback.completed;
+}
@@ -4,12 +4,21 @@
 #include <vector>
 #include <string>
 
+// Where an animation is in its frames; plain data so it can be snapshotted
+struct AnimationPlayback {
+    int frameIndex = 0;
+    float time = 0.0F; // Milliseconds into the current frame
+    bool completed = false;
+};
+
 class Animation {
 public:
     Animation();
     ~Animation();
 
     void addFrame(SDL_Texture* texture, int duration);
+    // Destroys every frame texture and rewinds, e.g. before re-slicing a reloaded sprite sheet
+    void clearFrames();
     void update(float deltaTime);
     [[nodiscard]] auto getCurrentFrame() const -> SDL_Texture*;
     [[nodiscard]] auto getFlip() const -> SDL_FlipMode;
@@ -21,6 +30,9 @@ public:
     [[nodiscard]] auto getCurrentFrameIndex() const -> int;
     [[nodiscard]] auto getTotalFrames() const -> int;
     bool hasCompleted() const;
+    [[nodiscard]] auto getPlayback() const -> AnimationPlayback;
+    // Clamps the frame index, in case the frames were reloaded since
+    void setPlayback(const AnimationPlayback& playback);
 
 private:
     struct Frame {
@@ -0,0 +1,148 @@
+#include "AssetCache.h"
+#include "AssetFileSystem.h"
+#include "Logging.h"
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+AssetCache::AssetCache(SDL_Renderer* renderer)
+    : renderer(renderer) {}
+
+AssetCache::~AssetCache() {
+    for (auto& [path, entry] : entries) {
+        if (entry.texture != nullptr) {
+            SDL_DestroyTexture(entry.texture);
+        }
+        if (entry.surface != nullptr) {
+            SDL_DestroySurface(entry.surface);
+        }
+    }
+}
+
+auto AssetCache::normalize(const std::string& path) -> std::string {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+void AssetCache::request(const std::string& path, AssetUsage usage) {
+    std::string key = normalize(path);
+    Entry& entry = entries[key];
+    if (entry.failed) {
+        return;
+    }
+
+    const bool available = usage == AssetUsage::Surface ? entry.surface != nullptr : entry.texture != nullptr;
+    (usage == AssetUsage::Surface ? entry.needsSurface : entry.needsTexture) = true;
+
+    // Loaded entries are decoded again if their surface was released or they never got a texture
+    if (entry.loaded && !available) {
+        entry.loaded = false;
+    }
+    if (!entry.loaded && std::find(pending.begin(), pending.end(), key) == pending.end()) {
+        pending.push_back(key);
+    }
+}
+
+auto AssetCache::loadPending() -> bool {
+    if (pending.empty()) {
+        return true;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point decodeStart = Clock::now();
+
+    std::vector<SDL_Surface*> decoded(pending.size(), nullptr);
+    std::vector<std::string> errors(pending.size());
+    std::atomic<size_t> nextIndex{0};
+    auto decode = [&]() {
+        for (size_t i = nextIndex.fetch_add(1); i < pending.size(); i = nextIndex.fetch_add(1)) {
+            SDL_IOStream* io = AssetFileSystem::openIO(pending[i]);
+            decoded[i] = io != nullptr ? IMG_Load_IO(io, true) : nullptr;
+            if (decoded[i] == nullptr) {
+                errors[i] = SDL_GetError();
+            }
+        }
+    };
+
+    const size_t workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, pending.size());
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i) {
+        workers.emplace_back(decode);
+    }
+    decode();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const Clock::time_point uploadStart = Clock::now();
+
+    // Textures can only be created on the thread that owns the renderer
+    bool success = true;
+    size_t textureCount = 0;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        Entry& entry = entries[pending[i]];
+        entry.loaded = true;
+        if (decoded[i] == nullptr) {
+            getLogger(LogSubsystem::Assets)->error("Failed to load image {}: {}", pending[i], errors[i]);
+            entry.failed = true;
+            success = false;
+            continue;
+        }
+
+        if (entry.needsTexture && entry.texture == nullptr) {
+            entry.texture = SDL_CreateTextureFromSurface(renderer, decoded[i]);
+            if (entry.texture == nullptr) {
+                getLogger(LogSubsystem::Assets)->error("Failed to create texture for {}: {}", pending[i], SDL_GetError());
+                entry.failed = true;
+                success = false;
+            } else {
+                SDL_SetTextureScaleMode(entry.texture, SDL_SCALEMODE_NEAREST);
+                textureCount++;
+            }
+        }
+
+        if (entry.needsSurface && entry.surface == nullptr) {
+            entry.surface = decoded[i];
+        } else {
+            SDL_DestroySurface(decoded[i]);
+        }
+    }
+
+    const Clock::time_point end = Clock::now();
+    getLogger(LogSubsystem::Assets)->info("Decoded {} images on {} threads in {:.1f} ms, created {} textures in {:.1f} ms", pending.size(), workerCount,
+                                          std::chrono::duration<double, std::milli>(uploadStart - decodeStart).count(), textureCount,
+                                          std::chrono::duration<double, std::milli>(end - uploadStart).count());
+    pending.clear();
+    return success;
+}
+
+auto AssetCache::find(const std::string& path, AssetUsage usage) -> Entry* {
+    request(path, usage);
+    Entry& entry = entries[normalize(path)];
+    if (!entry.loaded && !entry.failed) {
+        getLogger(LogSubsystem::Assets)->warn("Loading {} synchronously; request it before loadPending", path);
+        loadPending();
+    }
+    return &entry;
+}
+
+auto AssetCache::getSurface(const std::string& path) -> SDL_Surface* {
+    return find(path, AssetUsage::Surface)->surface;
+}
+
+auto AssetCache::getTexture(const std::string& path) -> SDL_Texture* {
+    return find(path, AssetUsage::Texture)->texture;
+}
+
+void AssetCache::releaseSurfaces() {
+    for (auto& [path, entry] : entries) {
+        if (entry.surface != nullptr) {
+            SDL_DestroySurface(entry.surface);
+            entry.surface = nullptr;
+        }
+        entry.needsSurface = false;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class AssetUsage {
+    Surface, // CPU-side pixels, e.g. sprite sheets that are cut into frames
+    Texture  // Drawn directly; the surface is dropped once the texture exists
+};
+
+// Startup image loader. Paths are requested up front, deduplicated, decoded
+// in parallel with IMG_Load_IO on worker threads, and handed back to the main
+// thread, which creates all textures in one batch. The cache owns every
+// surface and texture it returns.
+class AssetCache {
+public:
+    explicit AssetCache(SDL_Renderer* renderer);
+    ~AssetCache();
+
+    AssetCache(const AssetCache&) = delete;
+    auto operator=(const AssetCache&) -> AssetCache& = delete;
+
+    void request(const std::string& path, AssetUsage usage);
+    // Decodes every pending request; returns false if any image failed
+    auto loadPending() -> bool;
+
+    // Unrequested paths are loaded synchronously as a fallback; nullptr on failure
+    auto getSurface(const std::string& path) -> SDL_Surface*;
+    auto getTexture(const std::string& path) -> SDL_Texture*;
+
+    // Frees decoded surfaces once the startup code that cuts them up is done
+    void releaseSurfaces();
+
+private:
+    struct Entry {
+        SDL_Surface* surface = nullptr;
+        SDL_Texture* texture = nullptr;
+        bool needsSurface = false;
+        bool needsTexture = false;
+        bool loaded = false;
+        bool failed = false;
+    };
+
+    static auto normalize(const std::string& path) -> std::string;
+    auto find(const std::string& path, AssetUsage usage) -> Entry*;
+
+    SDL_Renderer* renderer;
+    std::unordered_map<std::string, Entry> entries;
+    std::vector<std::string> pending;
+};
@@ -0,0 +1,100 @@
+#include "AssetFileSystem.h"
+#include "AssetPack.h"
+#include "Logging.h"
+#include "Lz4.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+AssetPack pack;
+// Compressed entries are inflated once and kept until unmount, so their views stay valid like mapped ones
+std::mutex inflateMutex;
+std::unordered_map<const AssetPackEntry*, std::unique_ptr<uint8_t[]>> inflated;
+
+auto packKey(const std::string& path) -> std::string {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+// found distinguishes a zero-byte entry from a missing one
+auto findInPack(const std::string& path, bool& found) -> std::span<const uint8_t> {
+    found = false;
+    if (!pack.isOpen()) {
+        return {};
+    }
+    const AssetPackEntry* entry = pack.find(packKey(path));
+    if (entry == nullptr) {
+        return {};
+    }
+
+    if ((entry->flags & AssetPack::FLAG_LZ4) == 0) {
+        found = true;
+        return {pack.getStoredData(*entry), entry->size};
+    }
+
+    std::lock_guard<std::mutex> lock(inflateMutex);
+    auto it = inflated.find(entry);
+    if (it == inflated.end()) {
+        auto buffer = std::make_unique<uint8_t[]>(entry->size > 0 ? entry->size : 1);
+        if (!Lz4::decompress(pack.getStoredData(*entry), entry->storedSize, buffer.get(), entry->size)) {
+            getLogger(LogSubsystem::Assets)->error("Corrupt compressed entry {} in asset pack", path);
+            return {};
+        }
+        it = inflated.emplace(entry, std::move(buffer)).first;
+    }
+    found = true;
+    return {it->second.get(), entry->size};
+}
+
+} // namespace
+
+auto AssetFileSystem::mountPack(const std::string& packPath) -> bool {
+    unmount();
+    return pack.open(packPath);
+}
+
+void AssetFileSystem::unmount() {
+    std::lock_guard<std::mutex> lock(inflateMutex);
+    inflated.clear();
+    pack.close();
+}
+
+auto AssetFileSystem::isPackMounted() -> bool {
+    return pack.isOpen();
+}
+
+auto AssetFileSystem::openIO(const std::string& path) -> SDL_IOStream* {
+    bool found = false;
+    std::span<const uint8_t> view = findInPack(path, found);
+    if (found) {
+        return SDL_IOFromConstMem(view.data(), view.size());
+    }
+    return SDL_IOFromFile(path.c_str(), "rb");
+}
+
+auto AssetFileSystem::readText(const std::string& path, std::string& out) -> bool {
+    bool found = false;
+    std::span<const uint8_t> view = findInPack(path, found);
+    if (found) {
+        out.assign(reinterpret_cast<const char*>(view.data()), view.size());
+        return true;
+    }
+    return readLooseText(path, out);
+}
+
+auto AssetFileSystem::readLooseText(const std::string& path, std::string& out) -> bool {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    out = contents.str();
+    return true;
+}
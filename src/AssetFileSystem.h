@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+// Process-wide asset lookup. With a pack mounted, files are served as
+// read-only SDL_IOFromConstMem views into the mapping; paths missing from the
+// pack (or every path, when no pack is mounted) fall back to loose files so
+// edited assets can be tried without repacking.
+class AssetFileSystem {
+public:
+    static auto mountPack(const std::string& packPath) -> bool;
+    static void unmount();
+    [[nodiscard]] static auto isPackMounted() -> bool;
+
+    // Paths are relative to the working directory, e.g. "assets/tiles/ground.png".
+    // Returns nullptr and sets the SDL error if the file exists in neither place.
+    static auto openIO(const std::string& path) -> SDL_IOStream*;
+    static auto readText(const std::string& path, std::string& out) -> bool;
+    // Always reads from disk, e.g. to pick up an edit to a file the pack also contains
+    static auto readLooseText(const std::string& path, std::string& out) -> bool;
+};
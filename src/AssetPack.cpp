@@ -0,0 +1,152 @@
+#include "AssetPack.h"
+#include "Logging.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+auto AssetPack::open(const std::string& path) -> bool {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        getLogger(LogSubsystem::Assets)->error("Failed to open asset pack {}", path);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr) {
+        getLogger(LogSubsystem::Assets)->error("Failed to map asset pack {}", path);
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        getLogger(LogSubsystem::Assets)->error("Failed to open asset pack {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    struct stat info {};
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping keeps the file referenced
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        getLogger(LogSubsystem::Assets)->error("Failed to map asset pack {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!validate()) {
+        getLogger(LogSubsystem::Assets)->error("{} is not a valid version {} asset pack", path, VERSION);
+        close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const AssetPackHeader*>(data);
+    entries = {reinterpret_cast<const AssetPackEntry*>(data + sizeof(AssetPackHeader)), header->entryCount};
+    stringTable = reinterpret_cast<const char*>(entries.data() + entries.size());
+    getLogger(LogSubsystem::Assets)->info("Mapped asset pack {} ({} entries, {} KiB)", path, entries.size(), size / 1024);
+    return true;
+}
+
+void AssetPack::close() {
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    entries = {};
+    stringTable = nullptr;
+}
+
+auto AssetPack::validate() const -> bool {
+    if (size < sizeof(AssetPackHeader)) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+        return false;
+    }
+
+    const uint64_t indexEnd = sizeof(AssetPackHeader) + (uint64_t{header->entryCount} * sizeof(AssetPackEntry)) + header->stringTableSize;
+    if (indexEnd > size) {
+        return false;
+    }
+    const auto* records = reinterpret_cast<const AssetPackEntry*>(data + sizeof(AssetPackHeader));
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry& entry = records[i];
+        const bool pathInRange = uint64_t{entry.pathOffset} + entry.pathLength <= header->stringTableSize;
+        const bool dataInRange = entry.dataOffset >= indexEnd && entry.dataOffset <= size && entry.storedSize <= size - entry.dataOffset;
+        const bool sorted = i == 0 || records[i - 1].pathHash <= entry.pathHash;
+        const bool sizesMatch = (entry.flags & FLAG_LZ4) != 0 || entry.storedSize == entry.size;
+        if (!pathInRange || !dataInRange || !sorted || !sizesMatch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto AssetPack::getPath(const AssetPackEntry& entry) const -> std::string_view {
+    return {stringTable + entry.pathOffset, entry.pathLength};
+}
+
+auto AssetPack::find(std::string_view path) const -> const AssetPackEntry* {
+    const uint64_t hash = hashPath(path);
+    auto it = std::lower_bound(entries.begin(), entries.end(), hash,
+                               [](const AssetPackEntry& entry, uint64_t value) { return entry.pathHash < value; });
+    for (; it != entries.end() && it->pathHash == hash; ++it) {
+        if (getPath(*it) == path) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+auto AssetPack::getStoredData(const AssetPackEntry& entry) const -> const uint8_t* {
+    return data + entry.dataOffset;
+}
+
+auto AssetPack::hashPath(std::string_view path) -> uint64_t {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
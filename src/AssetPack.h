@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// On-disk layout: AssetPackHeader, entryCount AssetPackEntry records sorted by
+// pathHash, the path string table, then the entry data with every entry
+// starting on an AssetPack::ALIGNMENT boundary. Integers are little-endian.
+struct AssetPackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t stringTableSize;
+};
+
+struct AssetPackEntry {
+    uint64_t pathHash;
+    uint64_t dataOffset;
+    uint32_t pathOffset; // Into the string table; paths are not null-terminated
+    uint32_t pathLength;
+    uint32_t storedSize; // Bytes in the pack
+    uint32_t size;       // Bytes after decompression
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 16 && sizeof(AssetPackEntry) == 40, "Asset pack records are part of the file format");
+
+// Read-only, memory-mapped view of a pack written by asset_packer. Entry data
+// is served straight from the mapping; nothing is copied on open.
+class AssetPack {
+public:
+    static constexpr char MAGIC[4] = {'P', 'P', 'A', 'K'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t ALIGNMENT = 64;
+    static constexpr uint32_t FLAG_LZ4 = 1;
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    auto operator=(const AssetPack&) -> AssetPack& = delete;
+
+    auto open(const std::string& path) -> bool;
+    void close();
+
+    [[nodiscard]] auto isOpen() const -> bool { return data != nullptr; }
+    [[nodiscard]] auto getEntries() const -> std::span<const AssetPackEntry> { return entries; }
+    [[nodiscard]] auto getPath(const AssetPackEntry& entry) const -> std::string_view;
+    // Pack keys are relative paths with '/' separators, e.g. "assets/tiles/ground.png"
+    [[nodiscard]] auto find(std::string_view path) const -> const AssetPackEntry*;
+    // Compressed entries must be decoded with Lz4::decompress
+    [[nodiscard]] auto getStoredData(const AssetPackEntry& entry) const -> const uint8_t*;
+
+    // FNV-1a
+    [[nodiscard]] static auto hashPath(std::string_view path) -> uint64_t;
+
+private:
+    auto validate() const -> bool;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::span<const AssetPackEntry> entries;
+    const char* stringTable = nullptr;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
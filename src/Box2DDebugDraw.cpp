@@ -1,103 +1,210 @@
 #include "Box2DDebugDraw.h"
 #include "Utils.h"
+#include "RenderStats.h"
+#include <cmath>
 #include <cstdint>
 
-Box2DDebugDraw::Box2DDebugDraw(SDL_Renderer* renderer, float scale)
-    : renderer(renderer), scale(scale) {}
+constexpr float LINE_HALF_WIDTH = 0.5f;
+constexpr float AXIS_SCALE = 0.4f;
 
-void Box2DDebugDraw::DrawPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, void* context) {
+Box2DDebugDraw::Box2DDebugDraw(SDL_Renderer* renderer)
+    : renderer(renderer) {}
+
+auto Box2DDebugDraw::unitCircle() -> const std::array<b2Vec2, CIRCLE_SEGMENTS>& {
+    static const std::array<b2Vec2, CIRCLE_SEGMENTS> table = [] {
+        std::array<b2Vec2, CIRCLE_SEGMENTS> points{};
+        const float increment = 2.0f * b2_pi / static_cast<float>(CIRCLE_SEGMENTS);
+        for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+            float theta = increment * static_cast<float>(i);
+            points[i] = b2Vec2{std::cos(theta), std::sin(theta)};
+        }
+        return points;
+    }();
+    return table;
+}
+
+auto Box2DDebugDraw::toFColor(b2HexColor color) -> SDL_FColor {
     RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
-    for (int i = 0; i < vertexCount; ++i) {
-        SDL_FPoint v1 = Box2DToSDL(vertices[i], scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_FPoint v2 = Box2DToSDL(vertices[(i + 1) % vertexCount], scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
+    constexpr float inv = 1.0f / 255.0f;
+    return SDL_FColor{rgba.r * inv, rgba.g * inv, rgba.b * inv, rgba.a * inv};
+}
+
+void Box2DDebugDraw::addQuad(SDL_FPoint p0, SDL_FPoint p1, SDL_FPoint p2, SDL_FPoint p3, SDL_FColor color) {
+    int base = static_cast<int>(vertices.size());
+    vertices.push_back({p0, color, {0.0f, 0.0f}});
+    vertices.push_back({p1, color, {0.0f, 0.0f}});
+    vertices.push_back({p2, color, {0.0f, 0.0f}});
+    vertices.push_back({p3, color, {0.0f, 0.0f}});
+    indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+void Box2DDebugDraw::addLine(SDL_FPoint a, SDL_FPoint b, SDL_FColor color) {
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float length = std::sqrt((dx * dx) + (dy * dy));
+    if (length < 1e-4f) {
+        addQuad({a.x - LINE_HALF_WIDTH, a.y - LINE_HALF_WIDTH}, {a.x + LINE_HALF_WIDTH, a.y - LINE_HALF_WIDTH},
+                {a.x + LINE_HALF_WIDTH, a.y + LINE_HALF_WIDTH}, {a.x - LINE_HALF_WIDTH, a.y + LINE_HALF_WIDTH}, color);
+        return;
     }
+    float nx = -dy / length * LINE_HALF_WIDTH;
+    float ny = dx / length * LINE_HALF_WIDTH;
+    addQuad({a.x + nx, a.y + ny}, {b.x + nx, b.y + ny}, {b.x - nx, b.y - ny}, {a.x - nx, a.y - ny}, color);
 }
 
-void Box2DDebugDraw::DrawSolidPolygon(b2Transform transform, const b2Vec2* vertices, int vertexCount, float radius, b2HexColor color, void* context) {
-    RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
+void Box2DDebugDraw::addPolyline(const SDL_FPoint* points, int count, SDL_FColor color) {
+    for (int i = 0; i < count; ++i) {
+        addLine(points[i], points[(i + 1) % count], color);
+    }
+}
+
+void Box2DDebugDraw::DrawPolygon(const b2Vec2* points, int vertexCount, b2HexColor color, void* context) {
+    scratchPoints.resize(vertexCount);
+    camera.toScreen(std::span<const b2Vec2>(points, vertexCount), scratchPoints);
+    addPolyline(scratchPoints.data(), vertexCount, toFColor(color));
+}
+
+void Box2DDebugDraw::DrawSolidPolygon(b2Transform transform, const b2Vec2* points, int vertexCount, float radius, b2HexColor color, void* context) {
+    scratchPoints.resize(vertexCount);
     for (int i = 0; i < vertexCount; ++i) {
-        SDL_FPoint v1 = Box2DToSDL(vertices[i], scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_FPoint v2 = Box2DToSDL(vertices[(i + 1) % vertexCount], scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
+        scratchPoints[i] = camera.toScreen(b2TransformPoint(transform, points[i]));
     }
+    addPolyline(scratchPoints.data(), vertexCount, toFColor(color));
 }
 
 void Box2DDebugDraw::DrawCircle(b2Vec2 center, float radius, b2HexColor color, void* context) {
-    RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
-    const int segments = 16;
-    const float increment = 2.0f * b2_pi / static_cast<float>(segments);
-    float theta = 0.0f;
-    for (int i = 0; i < segments; ++i) {
-        b2Vec2 p1 = center + b2Vec2{radius * cosf(theta), radius * sinf(theta)};
-        b2Vec2 p2 = center + b2Vec2{radius * cosf(theta + increment), radius * sinf(theta + increment)};
-        SDL_FPoint v1 = Box2DToSDL(p1, scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_FPoint v2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
-        theta += increment;
+    const auto& circle = unitCircle();
+    SDL_FPoint points[CIRCLE_SEGMENTS];
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        points[i] = camera.toScreen(b2Vec2{center.x + (radius * circle[i].x), center.y + (radius * circle[i].y)});
     }
+    addPolyline(points, CIRCLE_SEGMENTS, toFColor(color));
 }
 
 void Box2DDebugDraw::DrawSolidCircle(b2Transform transform, float radius, b2HexColor color, void* context) {
-    RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
-    const int segments = 16;
-    const float increment = 2.0f * b2_pi / static_cast<float>(segments);
-    float theta = 0.0f;
-    for (int i = 0; i < segments; ++i) {
-        b2Vec2 p1 = transform.p + b2Vec2{radius * cosf(theta), radius * sinf(theta)};
-        b2Vec2 p2 = transform.p + b2Vec2{radius * cosf(theta + increment), radius * sinf(theta + increment)};
-        SDL_FPoint v1 = Box2DToSDL(p1, scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_FPoint v2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
-        theta += increment;
-    }
-    b2Vec2 p = transform.p + radius * b2Vec2{cosf(theta), sinf(theta)};
-    SDL_FPoint v = Box2DToSDL(p, scale, 0, 0, 0, 0);
-    SDL_RenderLine(renderer, transform.p.x * scale, transform.p.y * scale, v.x, v.y);
+    DrawCircle(transform.p, radius, color, context);
+    b2Vec2 rim = transform.p + radius * b2Rot_GetXAxis(transform.q);
+    addLine(camera.toScreen(transform.p), camera.toScreen(rim), toFColor(color));
 }
 
 void Box2DDebugDraw::DrawSegment(b2Vec2 p1, b2Vec2 p2, b2HexColor color, void* context) {
-    RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
-    SDL_FPoint v1 = Box2DToSDL(p1, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_FPoint v2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
+    addLine(camera.toScreen(p1), camera.toScreen(p2), toFColor(color));
 }
 
 void Box2DDebugDraw::DrawTransform(b2Transform transform, void* context) {
-    const float k_axisScale = 0.4f;
-    b2Vec2 p1 = transform.p, p2;
-
-    // Draw x-axis
-    p2 = p1 + k_axisScale * b2Rot_GetXAxis(transform.q);
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_FPoint v1 = Box2DToSDL(p1, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_FPoint v2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
-
-    // Draw y-axis
-    p2 = p1 + k_axisScale * b2Rot_GetYAxis(transform.q);
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    v2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_RenderLine(renderer, v1.x, v1.y, v2.x, v2.y);
+    SDL_FPoint origin = camera.toScreen(transform.p);
+    addLine(origin, camera.toScreen(transform.p + AXIS_SCALE * b2Rot_GetXAxis(transform.q)), SDL_FColor{1.0f, 0.0f, 0.0f, 1.0f});
+    addLine(origin, camera.toScreen(transform.p + AXIS_SCALE * b2Rot_GetYAxis(transform.q)), SDL_FColor{0.0f, 1.0f, 0.0f, 1.0f});
 }
 
 void Box2DDebugDraw::DrawPoint(b2Vec2 p, float size, b2HexColor color, void* context) {
-    RGBA8 rgba = MakeRGBA8(color, 1.0f);
-    SDL_SetRenderDrawColor(renderer, rgba.r, rgba.g, rgba.b, rgba.a);
-    SDL_FPoint v = Box2DToSDL(p, scale, offsetX, offsetY, windowWidth, windowHeight);
-    SDL_FRect rect;
-    rect.x = v.x - size / 2;
-    rect.y = v.y - size / 2;
-    rect.w = size;
-    rect.h = size;
-    SDL_RenderFillRect(renderer, &rect);
+    SDL_FPoint v = camera.toScreen(p);
+    float half = size / 2;
+    addQuad({v.x - half, v.y - half}, {v.x + half, v.y - half}, {v.x + half, v.y + half}, {v.x - half, v.y + half}, toFColor(color));
 }
 
 void Box2DDebugDraw::DrawString(b2Vec2 p, const char* s, void* context) {
     // Implement text rendering if needed, for now, we can leave it as a placeholder
-}
\ No newline at end of file
+}
+
+void Box2DDebugDraw::setStaticGeometry(const std::vector<std::vector<b2Vec2>>& loops) {
+    staticPoints.clear();
+    staticNormals.clear();
+    staticVertices.clear();
+    staticIndices.clear();
+
+    const SDL_FColor color = toFColor(b2_colorPaleGreen);
+    for (const auto& loop : loops) {
+        for (size_t i = 0; i < loop.size(); ++i) {
+            b2Vec2 p1 = loop[i];
+            b2Vec2 p2 = loop[(i + 1) % loop.size()];
+            // The camera is a uniform scale with a flipped y axis, so the screen normal is known up front
+            float dx = p2.x - p1.x;
+            float dy = p1.y - p2.y;
+            float length = std::sqrt((dx * dx) + (dy * dy));
+            SDL_FPoint normal = {0.0f, LINE_HALF_WIDTH};
+            if (length > 1e-6f) {
+                normal = {-dy / length * LINE_HALF_WIDTH, dx / length * LINE_HALF_WIDTH};
+            }
+            staticPoints.push_back(p1);
+            staticPoints.push_back(p2);
+            staticNormals.push_back(normal);
+
+            int base = static_cast<int>(staticVertices.size());
+            for (int corner = 0; corner < 4; ++corner) {
+                staticVertices.push_back({{0.0f, 0.0f}, color, {0.0f, 0.0f}});
+            }
+            staticIndices.insert(staticIndices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+    }
+    staticScreenPoints.resize(staticPoints.size());
+}
+
+void Box2DDebugDraw::drawStaticGeometry() {
+    if (staticNormals.empty()) return;
+
+    camera.toScreen(staticPoints, staticScreenPoints);
+
+    SDL_Vertex* out = staticVertices.data();
+    for (size_t i = 0; i < staticNormals.size(); ++i) {
+        SDL_FPoint a = staticScreenPoints[2 * i];
+        SDL_FPoint b = staticScreenPoints[(2 * i) + 1];
+        SDL_FPoint normal = staticNormals[i];
+        out[0].position = {a.x + normal.x, a.y + normal.y};
+        out[1].position = {b.x + normal.x, b.y + normal.y};
+        out[2].position = {b.x - normal.x, b.y - normal.y};
+        out[3].position = {a.x - normal.x, a.y - normal.y};
+        out += 4;
+    }
+    SDL_RenderGeometry(renderer, nullptr, staticVertices.data(), static_cast<int>(staticVertices.size()), staticIndices.data(), static_cast<int>(staticIndices.size()));
+    RenderStats::recordDraw(nullptr, static_cast<int>(staticVertices.size()));
+}
+
+void Box2DDebugDraw::drawMovingBodies(b2WorldId worldId) {
+    // The query reports each shape once, so bodies with any number of shapes need no buffer
+    b2World_OverlapAABB(worldId, getVisibleBounds(), b2DefaultQueryFilter(), [](b2ShapeId shapeId, void* context) {
+        if (b2Body_GetType(b2Shape_GetBody(shapeId)) != b2_staticBody) {
+            static_cast<Box2DDebugDraw*>(context)->drawShape(shapeId);
+        }
+        return true;
+    }, this);
+}
+
+void Box2DDebugDraw::drawShape(b2ShapeId shapeId) {
+    const b2BodyId bodyId = b2Shape_GetBody(shapeId);
+    const b2Transform transform = b2Body_GetTransform(bodyId);
+    const b2HexColor color = b2Body_IsAwake(bodyId) ? b2_colorPink : b2_colorGray;
+    switch (b2Shape_GetType(shapeId)) {
+        case b2_polygonShape: {
+            b2Polygon polygon = b2Shape_GetPolygon(shapeId);
+            DrawSolidPolygon(transform, polygon.vertices, polygon.count, polygon.radius, color, this);
+            break;
+        }
+        case b2_circleShape: {
+            b2Circle circle = b2Shape_GetCircle(shapeId);
+            DrawSolidCircle(b2Transform{b2TransformPoint(transform, circle.center), transform.q}, circle.radius, color, this);
+            break;
+        }
+        case b2_capsuleShape: {
+            b2Capsule capsule = b2Shape_GetCapsule(shapeId);
+            DrawSegment(b2TransformPoint(transform, capsule.center1), b2TransformPoint(transform, capsule.center2), color, this);
+            break;
+        }
+        case b2_segmentShape: {
+            b2Segment segment = b2Shape_GetSegment(shapeId);
+            DrawSegment(b2TransformPoint(transform, segment.point1), b2TransformPoint(transform, segment.point2), color, this);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void Box2DDebugDraw::flush() {
+    if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+        RenderStats::recordDraw(nullptr, static_cast<int>(vertices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
@@ -2,7 +2,10 @@
 
 #include <box2d/box2d.h>
 #include <SDL3/SDL.h>
+#include <array>
+#include <vector>
 #include "Utils.h"
+#include "CameraTransform.h"
 
 struct RGBA8
 {
@@ -14,16 +17,21 @@ static inline RGBA8 MakeRGBA8( b2HexColor c, float alpha )
 	return { uint8_t( ( c >> 16 ) & 0xFF ), uint8_t( ( c >> 8 ) & 0xFF ), uint8_t( c & 0xFF ), uint8_t( 0xFF * alpha ) };
 }
 
+// Collects Box2D debug primitives into a single vertex/index batch and submits it
+// with one SDL_RenderGeometry call per frame instead of one SDL call per edge.
 class Box2DDebugDraw {
 public:
-    Box2DDebugDraw(SDL_Renderer* renderer, float scale);
+    static constexpr int CIRCLE_SEGMENTS = 16;
 
-    void setScale(float newScale) { scale = newScale; }
-    void setOffset(float newOffsetX, float newOffsetY) { offsetX = newOffsetX; offsetY = newOffsetY; }
-    void setWindowSize(uint32_t newWindowWidth, uint32_t newWindowHeight) { windowWidth = newWindowWidth; windowHeight = newWindowHeight; }
+    explicit Box2DDebugDraw(SDL_Renderer* renderer);
 
-    void DrawPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, void* context);
-    void DrawSolidPolygon(b2Transform transform, const b2Vec2* vertices, int vertexCount, float radius, b2HexColor color,
+    void setCamera(const CameraTransform& newCamera) { camera = newCamera; }
+
+    // World-space rectangle currently visible through the camera, for b2DebugDraw::drawingBounds
+    [[nodiscard]] auto getVisibleBounds() const -> b2AABB { return camera.getVisibleBounds(); }
+
+    void DrawPolygon(const b2Vec2* points, int vertexCount, b2HexColor color, void* context);
+    void DrawSolidPolygon(b2Transform transform, const b2Vec2* points, int vertexCount, float radius, b2HexColor color,
 								void* context);
     void DrawCircle(b2Vec2 center, float radius, b2HexColor color, void* context);
     void DrawSolidCircle(b2Transform transform, float radius, b2HexColor color, void* context);
@@ -32,11 +40,38 @@ public:
     void DrawPoint(b2Vec2 p, float size, b2HexColor color, void* context);
     void DrawString(b2Vec2 p, const char* s, void* context);
 
+    // Record static chain loops once in world space; they are re-projected each frame without walking Box2D
+    void setStaticGeometry(const std::vector<std::vector<b2Vec2>>& loops);
+    [[nodiscard]] auto hasStaticGeometry() const -> bool { return !staticNormals.empty(); }
+    void drawStaticGeometry();
+
+    // Draws the shapes of every non-static body in the visible bounds; b2World_Draw
+    // cannot skip static bodies, so this replaces its shape pass when the cache is used
+    void drawMovingBodies(b2WorldId worldId);
+
+    // Submit everything batched since the last flush and clear the batch
+    void flush();
+
 private:
+    void addLine(SDL_FPoint a, SDL_FPoint b, SDL_FColor color);
+    void addQuad(SDL_FPoint p0, SDL_FPoint p1, SDL_FPoint p2, SDL_FPoint p3, SDL_FColor color);
+    void addPolyline(const SDL_FPoint* points, int count, SDL_FColor color);
+    void drawShape(b2ShapeId shapeId);
+
+    static auto toFColor(b2HexColor color) -> SDL_FColor;
+    static auto unitCircle() -> const std::array<b2Vec2, CIRCLE_SEGMENTS>&;
+
     SDL_Renderer* renderer;
-    float scale;
-    float offsetX = 0.0f;
-    float offsetY = 0.0f;
-    uint32_t windowWidth = 0;
-    uint32_t windowHeight = 0;
-};
\ No newline at end of file
+    CameraTransform camera;
+
+    // Segment endpoints are stored pairwise so the whole layer converts in one bulk call
+    std::vector<b2Vec2> staticPoints;
+    std::vector<SDL_FPoint> staticScreenPoints;
+    std::vector<SDL_FPoint> staticNormals; // Screen-space unit normals scaled to half the line width
+    std::vector<SDL_Vertex> staticVertices;
+    std::vector<int> staticIndices;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<SDL_FPoint> scratchPoints;
+};
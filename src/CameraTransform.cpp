@@ -0,0 +1,84 @@
+#include "CameraTransform.h"
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CAMERA_TRANSFORM_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CAMERA_TRANSFORM_SSE2 1
+#endif
+
+static_assert(sizeof(b2Vec2) == 2 * sizeof(float), "b2Vec2 must be two packed floats");
+static_assert(sizeof(SDL_FPoint) == 2 * sizeof(float), "SDL_FPoint must be two packed floats");
+
+namespace {
+
+// Both directions are out = in * (mulX, mulY) + (addX, addY) on interleaved x/y pairs
+void transformInterleaved(const float* in, float* out, size_t pointCount, float mulX, float mulY, float addX, float addY) {
+    size_t i = 0;
+    const size_t floatCount = pointCount * 2;
+
+#if defined(CAMERA_TRANSFORM_AVX2)
+    const __m256 mul8 = _mm256_setr_ps(mulX, mulY, mulX, mulY, mulX, mulY, mulX, mulY);
+    const __m256 add8 = _mm256_setr_ps(addX, addY, addX, addY, addX, addY, addX, addY);
+    for (; i + 8 <= floatCount; i += 8) {
+        __m256 v = _mm256_loadu_ps(in + i);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(v, mul8), add8));
+    }
+#endif
+
+#if defined(CAMERA_TRANSFORM_AVX2) || defined(CAMERA_TRANSFORM_SSE2)
+    const __m128 mul4 = _mm_setr_ps(mulX, mulY, mulX, mulY);
+    const __m128 add4 = _mm_setr_ps(addX, addY, addX, addY);
+    for (; i + 4 <= floatCount; i += 4) {
+        __m128 v = _mm_loadu_ps(in + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(v, mul4), add4));
+    }
+#endif
+
+    for (; i < floatCount; i += 2) {
+        out[i] = (in[i] * mulX) + addX;
+        out[i + 1] = (in[i + 1] * mulY) + addY;
+    }
+}
+
+} // namespace
+
+CameraTransform::CameraTransform(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight)
+    : scale(scale), windowWidth(windowWidth), windowHeight(windowHeight) {
+    // Same mapping as Box2DToSDL, folded into screen = (x * s + originX, originY - y * s)
+    totalScale = PIXELS_PER_METER * scale;
+    inverseScale = 1.0F / totalScale;
+    originX = (windowWidth / 2.0F) - (offsetX * totalScale);
+    originY = windowHeight + (windowHeight / 2.0F) + (offsetY * totalScale);
+}
+
+void CameraTransform::toScreen(std::span<const b2Vec2> worldPoints, std::span<SDL_FPoint> screenPoints) const {
+    assert(screenPoints.size() >= worldPoints.size());
+    transformInterleaved(reinterpret_cast<const float*>(worldPoints.data()), reinterpret_cast<float*>(screenPoints.data()),
+                         worldPoints.size(), totalScale, -totalScale, originX, originY);
+}
+
+void CameraTransform::toWorld(std::span<const SDL_FPoint> screenPoints, std::span<b2Vec2> worldPoints) const {
+    assert(worldPoints.size() >= screenPoints.size());
+    transformInterleaved(reinterpret_cast<const float*>(screenPoints.data()), reinterpret_cast<float*>(worldPoints.data()),
+                         screenPoints.size(), inverseScale, -inverseScale, -originX * inverseScale, originY * inverseScale);
+}
+
+auto CameraTransform::getVisibleBounds() const -> b2AABB {
+    b2AABB bounds;
+    bounds.lowerBound = toWorld(SDL_FPoint{0.0F, static_cast<float>(windowHeight)});
+    bounds.upperBound = toWorld(SDL_FPoint{static_cast<float>(windowWidth), 0.0F});
+    return bounds;
+}
+
+auto CameraTransform::simdPath() -> const char* {
+#if defined(CAMERA_TRANSFORM_AVX2)
+    return "avx2";
+#elif defined(CAMERA_TRANSFORM_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <span>
+#include "Utils.h"
+
+// World <-> screen mapping for one frame. Built once from the camera state and
+// then reused for every point, instead of recomputing the scale and window
+// terms per call like Box2DToSDL does.
+class CameraTransform {
+public:
+    CameraTransform() = default;
+    CameraTransform(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight);
+
+    [[nodiscard]] auto toScreen(b2Vec2 worldPos) const -> SDL_FPoint {
+        return SDL_FPoint{(worldPos.x * totalScale) + originX, originY - (worldPos.y * totalScale)};
+    }
+
+    [[nodiscard]] auto toWorld(SDL_FPoint screenPos) const -> b2Vec2 {
+        return b2Vec2{(screenPos.x - originX) * inverseScale, (originY - screenPos.y) * inverseScale};
+    }
+
+    // Bulk conversions; the output span must be at least as long as the input
+    void toScreen(std::span<const b2Vec2> worldPoints, std::span<SDL_FPoint> screenPoints) const;
+    void toWorld(std::span<const SDL_FPoint> screenPoints, std::span<b2Vec2> worldPoints) const;
+
+    // World-space rectangle covered by the window
+    [[nodiscard]] auto getVisibleBounds() const -> b2AABB;
+
+    [[nodiscard]] auto getScale() const -> float { return scale; }
+    [[nodiscard]] auto getPixelsPerMeter() const -> float { return totalScale; }
+    [[nodiscard]] auto getWindowWidth() const -> uint32_t { return windowWidth; }
+    [[nodiscard]] auto getWindowHeight() const -> uint32_t { return windowHeight; }
+
+    // Name of the SIMD path compiled into the bulk conversions
+    static auto simdPath() -> const char*;
+
+private:
+    float scale = 1.0F;
+    float totalScale = PIXELS_PER_METER;
+    float inverseScale = 1.0F / PIXELS_PER_METER;
+    float originX = 0.0F;
+    float originY = 0.0F;
+    uint32_t windowWidth = 0;
+    uint32_t windowHeight = 0;
+};
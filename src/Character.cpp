@@ -1,10 +1,12 @@
 #include "Character.h"
 #include "Utils.h"
-#include <SDL3_image/SDL_image.h>
-#include <nlohmann/json.hpp>
+#include "RenderStats.h"
+#include "AssetCache.h"
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <fstream>
-#include <spdlog/spdlog.h>
+#include "Logging.h"
 #include <imgui.h>
 
 // Define equality operator for b2ShapeId
@@ -16,66 +18,78 @@ inline bool operator==(const b2ShapeId& lhs, const b2ShapeId& rhs) {
 constexpr float TILE_SIZE = 32.0F;
 constexpr float LANDING_THRESHOLD = 0.2F; // Threshold time for landing animation
 
-Character::Character(SDL_Renderer* renderer, b2WorldId worldId, float x, float y, uint32_t windowWidth, uint32_t windowHeight, const nlohmann::json& characterConfig)
-    : renderer(renderer), worldId(worldId), windowWidth(windowWidth), windowHeight(windowHeight), showDebug(false), isOnGround(false), jumpCooldownTimer(0.0F), elapsedTime(0.0F), timeSinceLastGroundContact(0.0F), showDebugRectangles(false), showContactPoints(false), showForceVectors(false), debugColor({255, 0, 0, 255}), maxContactPoints(10) { // Initialize maxContactPoints
+Character::Character(SDL_Renderer* renderer, b2WorldId worldId, float x, float y, uint32_t windowWidth, uint32_t windowHeight, const CharacterConfig& characterConfig, AssetCache& assets)
+    : renderer(renderer), worldId(worldId), windowWidth(windowWidth), windowHeight(windowHeight), showDebug(false), isOnGround(false), jumpCooldownTimer(0.0F), elapsedTime(0.0F), timeSinceLastGroundContact(0.0F), showDebugRectangles(false), showContactPoints(false), showForceVectors(false), debugColor({255, 0, 0, 255}), maxContactPoints(10) {
     position = {x, y};
     
-    spdlog::debug("Initializing character at position ({}, {})", position.x, position.y);
-
-    // Store the provided configuration data
-    for (const auto& animation : characterConfig["animations"]) {
-        std::string name = animation["name"];
-        animationConfigs[name] = animation;
-    }
+    LOG_DEBUG(LogSubsystem::Character, "Initializing character at position ({}, {})", position.x, position.y);
 
     // Read character size from config
-    characterRectangle = {.x=characterConfig["initialPosition"]["x"], .y=characterConfig["initialPosition"]["y"], .w=characterConfig["characterSize"]["width"], .h=characterConfig["characterSize"]["height"]};
+    characterRectangle = {.x=static_cast<int>(characterConfig.initialX), .y=static_cast<int>(characterConfig.initialY), .w=characterConfig.width, .h=characterConfig.height};
 
+    controller = characterConfig.controller;
+    kinematicState.position = position;
     createBody();
-    loadIdleAnimation();
-    loadWalkingAnimation();
-    loadJumpingAnimation();
-    loadFallingAnimation();
-    loadLandingAnimation();
+    for (const AnimationConfig& animation : characterConfig.animations) {
+        SDL_Surface* sheet = assets.getSurface(animation.filePath);
+        if (sheet == nullptr) {
+            getLogger(LogSubsystem::Character)->error("Failed to load {} animation: {}", animation.name, SDL_GetError());
+            continue;
+        }
+        std::vector<AnimationFrames> frames = sliceAnimations(animation, sheet);
+        setAnimations(frames);
+    }
 
     currentAnimation = &idleAnimation;
 
     // Initialize acceleration values
-    groundAcceleration = characterConfig["groundAcceleration"];
-    airAcceleration = characterConfig["airAcceleration"];
-    maxWalkingSpeed = characterConfig["maxWalkingSpeed"];
-    jumpStrength = characterConfig["jumpStrength"];
+    groundAcceleration = characterConfig.groundAcceleration;
+    airAcceleration = characterConfig.airAcceleration;
+    maxWalkingSpeed = characterConfig.maxWalkingSpeed;
+    jumpStrength = characterConfig.jumpStrength;
+}
+
+void Character::requestAssets(const CharacterConfig& characterConfig, AssetCache& assets) {
+    for (const AnimationConfig& animation : characterConfig.animations) {
+        assets.request(animation.filePath, AssetUsage::Surface);
+    }
 }
 
 Character::~Character() {
-    spdlog::debug("Destroying character");
+    LOG_DEBUG(LogSubsystem::Character, "Destroying character");
     b2DestroyBody(bodyId);
 }
 
-void Character::handleInput(const SDL_Event& event) {
-    if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
-        bool keyDown = (event.type == SDL_EVENT_KEY_DOWN);
-        switch (event.key.key) {
-            case SDLK_LEFT:
-            case SDLK_A:
-                moveLeftRequested = keyDown;
-                break;
-            case SDLK_RIGHT:
-            case SDLK_D:
-                moveRightRequested = keyDown;
-                break;
-            case SDLK_UP:
-            case SDLK_W:
-                handleJumpInput(keyDown); // Call handleJumpInput here
-                break;
-        }
+void Character::applyInput(const TickInput& input) {
+    moveLeftRequested = input.isHeld(InputButton::Left);
+    moveRightRequested = input.isHeld(InputButton::Right);
+    dropThroughRequested = input.isHeld(InputButton::Down);
+
+    // Both windows count ticks, so jump timing does not depend on the frame rate
+    const bool jumpPressed = input.wasPressed(InputButton::Jump);
+    if (jumpPressed) {
+        jumpBufferTicks = JUMP_BUFFER_TICKS;
     }
+    if (isOnGround) {
+        coyoteTicks = COYOTE_TICKS;
+    }
+    if (jumpBufferTicks > 0 && coyoteTicks > 0) {
+        applyJumpImpulse();
+        jumpBufferTicks = 0;
+        coyoteTicks = 0;
+        return;
+    }
+    // Countdowns start on the tick after the press or after leaving the ground, so each window lasts its full length
+    jumpBufferTicks -= !jumpPressed && jumpBufferTicks > 0 ? 1 : 0;
+    coyoteTicks -= !isOnGround && coyoteTicks > 0 ? 1 : 0;
 }
 
 void Character::update(float deltaTime) {
     elapsedTime += deltaTime;
 
-    applyMovement(deltaTime);
+    if (controller == CharacterController::Dynamic) {
+        applyMovement(deltaTime);
+    }
 
     b2Vec2 velocity = b2Body_GetLinearVelocity(bodyId);
 
@@ -122,12 +136,14 @@ void Character::update(float deltaTime) {
     updateDebugColor();
 }
 
-void Character::render(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight) {
+void Character::render(const CameraTransform& camera) {
+    const float scale = camera.getScale();
+
     // Fetch the current character position from the physics body
     position = b2Body_GetPosition(bodyId);
 
     // Convert the position to screen coordinates
-    SDL_FPoint screenPos = Box2DToSDL(position, scale, offsetX, offsetY, windowWidth, windowHeight);
+    SDL_FPoint screenPos = camera.toScreen(position);
 
     // Render character using current animation
     SDL_Texture* currentFrame = currentAnimation->getCurrentFrame();
@@ -140,6 +156,7 @@ void Character::render(float scale, float offsetX, float offsetY, uint32_t windo
 
         };
         SDL_RenderTextureRotated(renderer, currentFrame, nullptr, &dstRect, 0.0, nullptr, currentAnimation->getFlip());
+        RenderStats::recordDraw(currentFrame, 4);
     }
 
     // Draw debug rectangles around the character
@@ -152,6 +169,7 @@ void Character::render(float scale, float offsetX, float offsetY, uint32_t windo
             characterRectangle.h * scale
         };
         SDL_RenderRect(renderer, &debugRect);
+        RenderStats::recordDraw(nullptr, 5);
     }
 
     if (showForceVectors) {
@@ -162,12 +180,13 @@ void Character::render(float scale, float offsetX, float offsetY, uint32_t windo
         };
         SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255); // Blue for gravity
         SDL_RenderLine(renderer, screenPos.x, screenPos.y, forceEndPos.x, forceEndPos.y);
+        RenderStats::recordDraw(nullptr, 2);
     }
 
     if (showContactPoints) {
         const int pointSize = 5; 
         for (const auto& contactPoint : contactPoints) {
-            SDL_FPoint contactScreenPos = Box2DToSDL(contactPoint, scale, offsetX, offsetY, windowWidth, windowHeight);
+            SDL_FPoint contactScreenPos = camera.toScreen(contactPoint);
             SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red for contact points
 
             SDL_FRect contactRect = {
@@ -177,6 +196,7 @@ void Character::render(float scale, float offsetX, float offsetY, uint32_t windo
                 pointSize
             };
             SDL_RenderFillRect(renderer, &contactRect);
+            RenderStats::recordDraw(nullptr, 4);
         }
     }
 }
@@ -223,18 +243,16 @@ void Character::setShowForceVectors(bool value) {
     showForceVectors = value;
 }
 
-void Character::handleJumpInput(bool keyDown) {
-    jumpRequested = keyDown;
-    if (keyDown && isOnGround) {
-        applyJumpImpulse();
-    }
-}
-
 void Character::applyJumpImpulse() {
-    b2Vec2 impulse = {0.0F, jumpStrength};
-    b2Body_ApplyLinearImpulse(bodyId, impulse, position, true);
+    if (controller == CharacterController::Kinematic) {
+        // The same change in speed the impulse gives the dynamic body
+        kinematicState.velocity.y = jumpStrength / bodyMass;
+        kinematicState.grounded = false;
+    } else {
+        b2Vec2 impulse = {0.0F, jumpStrength};
+        b2Body_ApplyLinearImpulse(bodyId, impulse, position, true);
+    }
     isOnGround = false;
-    jumpRequested = false; // Reset jumpRequested after applying jump impulse
 }
 
 void Character::applyMovement(float deltaTime) {
@@ -244,25 +262,57 @@ void Character::applyMovement(float deltaTime) {
     // Handle horizontal movement
     if (moveLeftRequested) {
         velocity.x = std::max(velocity.x - acceleration * deltaTime, -maxWalkingSpeed);
-        if (isFacingRight) {
-            isFacingRight = false;
-            flipAnimation(isFacingRight);
-        }
     }
     if (moveRightRequested) {
         velocity.x = std::min(velocity.x + acceleration * deltaTime, maxWalkingSpeed);
-        if (!isFacingRight) {
-            isFacingRight = true;
-            flipAnimation(isFacingRight);
-        }
     }
+    updateFacing();
 
     b2Body_SetLinearVelocity(bodyId, velocity);
 }
 
+void Character::prepareStep(float deltaTime) {
+    if (controller == CharacterController::Kinematic) {
+        applyKinematicMovement(deltaTime);
+    }
+}
+
+void Character::applyKinematicMovement(float deltaTime) {
+    static const TileCollisionGrid emptyGrid;
+    KinematicParams params;
+    params.halfWidth = characterRectangle.w / (2.0F * PIXELS_PER_METER);
+    params.halfHeight = characterRectangle.h / (2.0F * PIXELS_PER_METER);
+    params.gravity = b2World_GetGravity(worldId).y;
+    params.groundAcceleration = groundAcceleration;
+    params.airAcceleration = airAcceleration;
+    params.maxWalkingSpeed = maxWalkingSpeed;
+
+    KinematicInput input;
+    input.move = (moveRightRequested ? 1.0F : 0.0F) - (moveLeftRequested ? 1.0F : 0.0F);
+    input.dropThrough = dropThroughRequested;
+    KinematicController::step(collisionGrid != nullptr ? *collisionGrid : emptyGrid, params, input, deltaTime, kinematicState);
+    isOnGround = kinematicState.grounded;
+    updateFacing();
+
+    // Box2D moves the body to the new position during the step, pushing dynamic props on the way
+    b2Body_SetLinearVelocity(bodyId, (1.0F / deltaTime) * (kinematicState.position - b2Body_GetPosition(bodyId)));
+}
+
+void Character::updateFacing() {
+    if (moveLeftRequested && isFacingRight) {
+        isFacingRight = false;
+        flipAnimation(isFacingRight);
+    }
+    if (moveRightRequested && !isFacingRight) {
+        isFacingRight = true;
+        flipAnimation(isFacingRight);
+    }
+}
+
 void Character::createBody() {
     b2BodyDef bodyDef = b2DefaultBodyDef();
-    bodyDef.type = b2_dynamicBody;
+    // A kinematic body is moved by KinematicController and only pushes dynamic props around
+    bodyDef.type = controller == CharacterController::Kinematic ? b2_kinematicBody : b2_dynamicBody;
     bodyDef.position = position;
     bodyDef.fixedRotation = true;
     
@@ -292,209 +342,98 @@ void Character::createBody() {
     shapeDef.friction = 0.3F;
     shapeDef.restitution = 0.0F;
     b2CreatePolygonShape(bodyId, &shapeDef, &roundedBox);
+    bodyMass = b2ComputePolygonMass(&roundedBox, shapeDef.density).mass;
 
     b2Body_SetGravityScale(bodyId, 1.0F);
 }
 
-void Character::loadIdleAnimation() {
-    auto& config = animationConfigs["idle"];
-    SDL_Surface* surface = IMG_Load(config["filePath"].get<std::string>().c_str());
-    if (surface == nullptr) {
-        spdlog::error("Failed to load idle animation: {}", SDL_GetError());
-        return;
-    }
-
-    int frameWidth = config["frameSize"]["width"];
-    int frameHeight = config["frameSize"]["height"];
-    int characterSpriteWidth = config["characterSpriteSize"]["width"];
-    int characterSpriteHeight = config["characterSpriteSize"]["height"];
-    int characterSpritePosX = config["characterSpritePosition"]["x"];
-    int characterSpritePosY = config["characterSpritePosition"]["y"];
-    int frameCount = config["frameCount"];
-    int animationSpeed = static_cast<int>(config["animationSpeed"].get<float>() * 1000);
-
-    for (int i = 0; i < frameCount; ++i) {
-        SDL_Surface* frameSurface = SDL_CreateSurface(characterSpriteWidth, characterSpriteHeight, SDL_PIXELFORMAT_RGBA8888);
-        SDL_Rect srcRect = {
-            characterSpritePosX + (i * frameWidth) - (characterSpriteWidth/2),
-            characterSpritePosY + (characterSpriteHeight/2),
-            characterSpriteWidth,
-            characterSpriteHeight
-        };
-        SDL_BlitSurface(surface, &srcRect, frameSurface, nullptr);
-
-        SDL_Texture* frameTexture = SDL_CreateTextureFromSurface(renderer, frameSurface);
-        idleAnimation.addFrame(frameTexture, animationSpeed);
+auto Character::sliceAnimations(const AnimationConfig& config, SDL_Surface* sheet) -> std::vector<AnimationFrames> {
+    const int animationSpeed = static_cast<int>(config.animationSpeed * 1000);
+
+    std::vector<AnimationFrames> animations;
+    auto addFrames = [&](const std::string& name, int startFrame, int frameCount, bool looping) {
+        auto it = std::find_if(animations.begin(), animations.end(), [&](const AnimationFrames& frames) { return frames.name == name; });
+        AnimationFrames& animation = it != animations.end() ? *it : animations.emplace_back(AnimationFrames{name, {}, animationSpeed, looping});
+        animation.looping = looping;
+        for (int i = 0; i < frameCount; ++i) {
+            SurfacePtr frameSurface(SDL_CreateSurface(config.spriteWidth, config.spriteHeight, SDL_PIXELFORMAT_RGBA8888));
+            SDL_Rect srcRect = {
+                config.spriteX + ((startFrame + i) * config.frameWidth) - (config.spriteWidth / 2),
+                config.spriteY + (config.spriteHeight / 2),
+                config.spriteWidth,
+                config.spriteHeight
+            };
+            SDL_BlitSurface(sheet, &srcRect, frameSurface.get(), nullptr);
+            animation.frames.push_back(std::move(frameSurface));
+        }
+    };
 
-        SDL_DestroySurface(frameSurface);
+    // A sheet either holds one animation or is split into typed frame ranges (the jumping sheet)
+    if (config.frames.empty()) {
+        addFrames(config.name, 0, config.frameCount, config.looping);
+        return animations;
     }
-
-    SDL_DestroySurface(surface);
-}
-
-void Character::loadWalkingAnimation() {
-    auto& config = animationConfigs["walking"];
-    SDL_Surface* surface = IMG_Load(config["filePath"].get<std::string>().c_str());
-    if (surface == nullptr) {
-        spdlog::error("Failed to load walking animation: {}", SDL_GetError());
-        return;
+    for (const FrameRange& range : config.frames) {
+        addFrames(range.type == "jump" ? "jumping" : range.type, range.startFrame, range.frameCount, range.looping);
     }
-
-    int frameWidth = config["frameSize"]["width"];
-    int frameHeight = config["frameSize"]["height"];
-    int characterSpriteWidth = config["characterSpriteSize"]["width"];
-    int characterSpriteHeight = config["characterSpriteSize"]["height"];
-    int characterSpritePosX = config["characterSpritePosition"]["x"];
-    int characterSpritePosY = config["characterSpritePosition"]["y"];
-    int frameCount = config["frameCount"];
-    int animationSpeed = static_cast<int>(config["animationSpeed"].get<float>() * 1000);
-
-    for (int i = 0; i < frameCount; ++i) {
-        SDL_Surface* frameSurface = SDL_CreateSurface(characterSpriteWidth, characterSpriteHeight, SDL_PIXELFORMAT_RGBA8888);
-        SDL_Rect srcRect = {
-            characterSpritePosX + (i * frameWidth) - (characterSpriteWidth/2),
-            characterSpritePosY + (characterSpriteHeight/2),
-            characterSpriteWidth,
-            characterSpriteHeight
-        };
-        SDL_BlitSurface(surface, &srcRect, frameSurface, nullptr);
-
-        SDL_Texture* frameTexture = SDL_CreateTextureFromSurface(renderer, frameSurface);
-        walkingAnimation.addFrame(frameTexture, animationSpeed);
-
-        SDL_DestroySurface(frameSurface);
-    }
-
-    SDL_DestroySurface(surface);
+    return animations;
 }
 
-void Character::loadJumpingAnimation() {
-    auto& config = animationConfigs["jumping"];
-    SDL_Surface* surface = IMG_Load(config["filePath"].get<std::string>().c_str());
-    if (surface == nullptr) {
-        spdlog::error("Failed to load jumping animation: {}", SDL_GetError());
-        return;
-    }
-
-    int frameWidth = config["frameSize"]["width"];
-    int frameHeight = config["frameSize"]["height"];
-    int characterSpriteWidth = config["characterSpriteSize"]["width"];
-    int characterSpriteHeight = config["characterSpriteSize"]["height"];
-    int characterSpritePosX = config["characterSpritePosition"]["x"];
-    int characterSpritePosY = config["characterSpritePosition"]["y"];
-    int animationSpeed = static_cast<int>(config["animationSpeed"].get<float>() * 1000);
-
-    for (const auto& frame : config["frames"]) {
-        if (frame["type"] == "jump") {
-            int startFrame = frame["startFrame"];
-            int frameCount = frame["frameCount"];
-            bool looping = frame.value("looping", config.value("looping", false));
-            for (int i = 0; i < frameCount; ++i) {
-                SDL_Surface* frameSurface = SDL_CreateSurface(characterSpriteWidth, characterSpriteHeight, SDL_PIXELFORMAT_RGBA8888);
-                SDL_Rect srcRect = {
-                    characterSpritePosX + ((startFrame + i) * frameWidth) - (characterSpriteWidth / 2),
-                    characterSpritePosY + (characterSpriteHeight / 2),
-                    characterSpriteWidth,
-                    characterSpriteHeight
-                };
-                SDL_BlitSurface(surface, &srcRect, frameSurface, nullptr);
-
-                SDL_Texture* frameTexture = SDL_CreateTextureFromSurface(renderer, frameSurface);
-                jumpingAnimation.addFrame(frameTexture, animationSpeed);
-
-                SDL_DestroySurface(frameSurface);
-            }
-            jumpingAnimation.setLooping(looping);
+void Character::setAnimations(std::vector<AnimationFrames>& animations) {
+    for (AnimationFrames& frames : animations) {
+        Animation* animation = findAnimation(frames.name);
+        if (animation == nullptr) {
+            getLogger(LogSubsystem::Character)->warn("Unknown animation '{}'", frames.name);
+            continue;
         }
-    }
-
-    SDL_DestroySurface(surface);
-}
-
-void Character::loadFallingAnimation() {
-    auto& config = animationConfigs["jumping"];
-    SDL_Surface* surface = IMG_Load(config["filePath"].get<std::string>().c_str());
-    if (surface == nullptr) {
-        spdlog::error("Failed to load falling animation: {}", SDL_GetError());
-        return;
-    }
-
-    int frameWidth = config["frameSize"]["width"];
-    int frameHeight = config["frameSize"]["height"];
-    int characterSpriteWidth = config["characterSpriteSize"]["width"];
-    int characterSpriteHeight = config["characterSpriteSize"]["height"];
-    int characterSpritePosX = config["characterSpritePosition"]["x"];
-    int characterSpritePosY = config["characterSpritePosition"]["y"];
-    int animationSpeed = static_cast<int>(config["animationSpeed"].get<float>() * 1000);
-
-    for (const auto& frame : config["frames"]) {
-        if (frame["type"] == "falling") {
-            int startFrame = frame["startFrame"];
-            int frameCount = frame["frameCount"];
-            bool looping = frame.value("looping", config.value("looping", false));
-            for (int i = 0; i < frameCount; ++i) {
-                SDL_Surface* frameSurface = SDL_CreateSurface(characterSpriteWidth, characterSpriteHeight, SDL_PIXELFORMAT_RGBA8888);
-                SDL_Rect srcRect = {
-                    characterSpritePosX + ((startFrame + i) * frameWidth) - (characterSpriteWidth / 2),
-                    characterSpritePosY + (characterSpriteHeight / 2),
-                    characterSpriteWidth,
-                    characterSpriteHeight
-                };
-                SDL_BlitSurface(surface, &srcRect, frameSurface, nullptr);
-
-                SDL_Texture* frameTexture = SDL_CreateTextureFromSurface(renderer, frameSurface);
-                fallingAnimation.addFrame(frameTexture, animationSpeed);
-
-                SDL_DestroySurface(frameSurface);
-            }
-            fallingAnimation.setLooping(looping);
+        animation->clearFrames();
+        for (const SurfacePtr& frame : frames.frames) {
+            animation->addFrame(SDL_CreateTextureFromSurface(renderer, frame.get()), frames.frameDuration);
         }
+        animation->setLooping(frames.looping);
     }
-
-    SDL_DestroySurface(surface);
 }
 
-void Character::loadLandingAnimation() {
-    auto& config = animationConfigs["jumping"];
-    SDL_Surface* surface = IMG_Load(config["filePath"].get<std::string>().c_str());
-    if (surface == nullptr) {
-        spdlog::error("Failed to load landing animation: {}", SDL_GetError());
-        return;
-    }
+auto Character::findAnimation(const std::string& name) -> Animation* {
+    if (name == "idle") return &idleAnimation;
+    if (name == "walking") return &walkingAnimation;
+    if (name == "jumping") return &jumpingAnimation;
+    if (name == "falling") return &fallingAnimation;
+    if (name == "landing") return &landingAnimation;
+    return nullptr;
+}
 
-    int frameWidth = config["frameSize"]["width"];
-    int frameHeight = config["frameSize"]["height"];
-    int characterSpriteWidth = config["characterSpriteSize"]["width"];
-    int characterSpriteHeight = config["characterSpriteSize"]["height"];
-    int characterSpritePosX = config["characterSpritePosition"]["x"];
-    int characterSpritePosY = config["characterSpritePosition"]["y"];
-    int animationSpeed = static_cast<int>(config["animationSpeed"].get<float>() * 1000);
-
-    for (const auto& frame : config["frames"]) {
-        if (frame["type"] == "landing") {
-            int startFrame = frame["startFrame"];
-            int frameCount = frame["frameCount"];
-            bool looping = frame.value("looping", config.value("looping", false));
-            for (int i = 0; i < frameCount; ++i) {
-                SDL_Surface* frameSurface = SDL_CreateSurface(characterSpriteWidth, characterSpriteHeight, SDL_PIXELFORMAT_RGBA8888);
-                SDL_Rect srcRect = {
-                    characterSpritePosX + ((startFrame + i) * frameWidth) - (characterSpriteWidth / 2),
-                    characterSpritePosY + (characterSpriteHeight / 2),
-                    characterSpriteWidth,
-                    characterSpriteHeight
-                };
-                SDL_BlitSurface(surface, &srcRect, frameSurface, nullptr);
-
-                SDL_Texture* frameTexture = SDL_CreateTextureFromSurface(renderer, frameSurface);
-                landingAnimation.addFrame(frameTexture, animationSpeed);
-
-                SDL_DestroySurface(frameSurface);
-            }
-            landingAnimation.setLooping(looping);
-        }
-    }
+void Character::saveState(CharacterSnapshot& snapshot) const {
+    const std::array<const Animation*, 5> animations = {&idleAnimation, &walkingAnimation, &jumpingAnimation, &fallingAnimation, &landingAnimation};
+    snapshot.position = position;
+    snapshot.kinematicState = kinematicState;
+    snapshot.animation = currentAnimation->getPlayback();
+    snapshot.elapsedTime = elapsedTime;
+    snapshot.timeSinceLastGroundContact = timeSinceLastGroundContact;
+    snapshot.jumpCooldownTimer = jumpCooldownTimer;
+    snapshot.jumpBufferTicks = jumpBufferTicks;
+    snapshot.coyoteTicks = coyoteTicks;
+    snapshot.animationIndex = static_cast<uint8_t>(std::find(animations.begin(), animations.end(), currentAnimation) - animations.begin());
+    snapshot.isOnGround = isOnGround;
+    snapshot.wasOnGround = wasOnGround;
+    snapshot.isFacingRight = isFacingRight;
+}
 
-    SDL_DestroySurface(surface);
+void Character::restoreState(const CharacterSnapshot& snapshot) {
+    const std::array<Animation*, 5> animations = {&idleAnimation, &walkingAnimation, &jumpingAnimation, &fallingAnimation, &landingAnimation};
+    position = snapshot.position;
+    kinematicState = snapshot.kinematicState;
+    currentAnimation = animations[std::min<size_t>(snapshot.animationIndex, animations.size() - 1)];
+    currentAnimation->setPlayback(snapshot.animation);
+    elapsedTime = snapshot.elapsedTime;
+    timeSinceLastGroundContact = snapshot.timeSinceLastGroundContact;
+    jumpCooldownTimer = snapshot.jumpCooldownTimer;
+    jumpBufferTicks = snapshot.jumpBufferTicks;
+    coyoteTicks = snapshot.coyoteTicks;
+    isOnGround = snapshot.isOnGround;
+    wasOnGround = snapshot.wasOnGround;
+    isFacingRight = snapshot.isFacingRight;
+    flipAnimation(isFacingRight);
 }
 
 void Character::showDebugWindow(bool show) {
@@ -559,6 +498,9 @@ void Character::displayCurrentAnimationInfo() {
 }
 
 void Character::checkGroundContact() {
+    if (controller == CharacterController::Kinematic) {
+        return; // Grounded comes from the tile grid
+    }
     b2ContactEvents contactEvents = b2World_GetContactEvents(worldId);
 
     // Check begin contact events
@@ -573,16 +515,15 @@ void Character::checkGroundContact() {
                 if (contactData[j].manifold.normal.y > 0) {
                     isOnGround = true;
                     for (int k = 0; k < contactData[j].manifold.pointCount; ++k) {
-                        contactPoints.push_back(contactData[j].manifold.points[k].point);
+                        contactPoints.push(contactData[j].manifold.points[k].point);
                     }
+                    contactPoints.truncateFront(static_cast<size_t>(maxContactPoints));
                     break;
                 }
             }
         }
     }
 
-    setMaxContactPoints(maxContactPoints);
-
     // Check end contact events
     for (int i = 0; i < contactEvents.endCount; ++i) {
         b2ContactEndTouchEvent endEvent = contactEvents.endEvents[i];
@@ -614,9 +555,11 @@ void Character::updateDebugColor() {
     }
 }
 
+auto Character::getBodyId() const -> b2BodyId {
+    return bodyId;
+}
+
 void Character::setMaxContactPoints(int maxPoints) {
-    maxContactPoints = maxPoints;
-    while (contactPoints.size() > maxContactPoints) {
-        contactPoints.pop_front();
-    }
+    maxContactPoints = std::clamp(maxPoints, 0, static_cast<int>(CONTACT_POINT_CAPACITY));
+    contactPoints.truncateFront(static_cast<size_t>(maxContactPoints));
 }
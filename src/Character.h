@@ -2,21 +2,72 @@
 
 #include <SDL3/SDL.h>
 #include <box2d/box2d.h>
-#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include "Animation.h"
-#include <unordered_map>
+#include "CameraTransform.h"
+#include <memory>
 #include <string>
-#include <deque>
+#include <vector>
+#include "GameConfig.h"
+#include "InputBuffer.h"
+#include "KinematicController.h"
+#include "RingBuffer.h"
+
+class AssetCache;
+
+struct SurfaceDeleter {
+    void operator()(SDL_Surface* surface) const { SDL_DestroySurface(surface); }
+};
+using SurfacePtr = std::unique_ptr<SDL_Surface, SurfaceDeleter>;
+
+// One animation's frames cut from its sprite sheet, waiting to be uploaded as textures
+struct AnimationFrames {
+    std::string name; // "idle", "walking", "jumping", "falling" or "landing"
+    std::vector<SurfacePtr> frames;
+    int frameDuration = 0; // Milliseconds
+    bool looping = true;
+};
+
+// Gameplay state of a character, for WorldSnapshot. Its body is snapshotted
+// separately; held input is not state and is left alone on restore.
+struct CharacterSnapshot {
+    b2Vec2 position{};
+    KinematicState kinematicState;
+    AnimationPlayback animation;
+    float elapsedTime = 0.0F;
+    float timeSinceLastGroundContact = 0.0F;
+    float jumpCooldownTimer = 0.0F;
+    uint8_t jumpBufferTicks = 0;
+    uint8_t coyoteTicks = 0;
+    uint8_t animationIndex = 0; // Into idle, walking, jumping, falling, landing
+    bool isOnGround = false;
+    bool wasOnGround = false;
+    bool isFacingRight = true;
+};
 
 class Character {
 public:
-    Character(SDL_Renderer* renderer, b2WorldId worldId, float x, float y, uint32_t windowWidth, uint32_t windowHeight, const nlohmann::json& characterConfig);
+    static constexpr uint8_t JUMP_BUFFER_TICKS = 6; // A jump pressed up to this many ticks before landing still happens
+    static constexpr uint8_t COYOTE_TICKS = 6;      // Jumping is still allowed for this many airborne ticks after leaving the ground
+
+    Character(SDL_Renderer* renderer, b2WorldId worldId, float x, float y, uint32_t windowWidth, uint32_t windowHeight, const CharacterConfig& characterConfig, AssetCache& assets);
+
+    // Queue the sprite sheets named in characterConfig so they decode with the level's images
+    static void requestAssets(const CharacterConfig& characterConfig, AssetCache& assets);
+    // Cuts the animations described by one config entry out of its sprite sheet.
+    // Only touches surfaces, so the hot-reload thread runs it too.
+    static auto sliceAnimations(const AnimationConfig& config, SDL_Surface* sheet) -> std::vector<AnimationFrames>;
     ~Character();
 
-    void handleInput(const SDL_Event& event);
+    // Takes one tick of input, from InputBuffer or a script, and starts a buffered
+    // jump if one is allowed; call once per tick, before b2World_Step
+    void applyInput(const TickInput& input);
+    // Moves a kinematic character through the collision grid and gives its body the
+    // velocity that reaches the new position during the step; call after applyInput,
+    // before b2World_Step. Does nothing for the dynamic controller.
+    void prepareStep(float deltaTime);
     void update(float deltaTime);
-    void render(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight);
+    void render(const CameraTransform& camera);
     void setMaxWalkingSpeed(float speed);
     void showDebugWindow(bool show);
     void checkGroundContact();
@@ -24,7 +75,6 @@ public:
     void setJumpStrength(float strength);
     void setJumpCooldownDuration(float duration);
 
-    void handleJumpInput(bool keyDown);
     void applyJumpImpulse();
     void updateJumpState(float deltaTime);
 
@@ -35,6 +85,16 @@ public:
     void setShowContactPoints(bool value);
     void setShowForceVectors(bool value);
     void setMaxContactPoints(int maxPoints); 
+    // Uploads the frames and replaces the animations they name
+    void setAnimations(std::vector<AnimationFrames>& animations);
+    // Used by the kinematic controller; not owned, typically Level::getCollisionGrid()
+    void setCollisionGrid(const TileCollisionGrid* grid) { collisionGrid = grid; }
+
+    void saveState(CharacterSnapshot& snapshot) const;
+    void restoreState(const CharacterSnapshot& snapshot);
+
+    [[nodiscard]] auto getBodyId() const -> b2BodyId;
+    [[nodiscard]] auto isGrounded() const -> bool { return isOnGround; }
 
 private:
     SDL_Renderer* renderer;
@@ -61,11 +121,10 @@ private:
 
     bool moveLeftRequested {false};
     bool moveRightRequested {false};
-    bool jumpRequested {false};
+    uint8_t jumpBufferTicks {0}; // Ticks left in which a pressed jump waits for the ground
+    uint8_t coyoteTicks {0};     // Ticks left in which a jump is allowed without ground contact
     bool isFacingRight {true};
 
-    std::unordered_map<std::string, nlohmann::json> animationConfigs;
-
     float debugPrintInterval;
     float elapsedTime;
     float timeSinceLastGroundContact;
@@ -83,19 +142,24 @@ private:
     bool showContactPoints;
     bool showForceVectors;
     SDL_Color debugColor;
-    std::deque<b2Vec2> contactPoints; // Change to deque
-    int maxContactPoints; // Add this line
+    static constexpr size_t CONTACT_POINT_CAPACITY = 128; // Covers the developer menu's 1-100 range
+    RingBuffer<b2Vec2, CONTACT_POINT_CAPACITY> contactPoints;
+    int maxContactPoints;
+
+    CharacterController controller;
+    float bodyMass = 1.0F; // Converts jumpStrength, an impulse, into the kinematic take-off speed
+    KinematicState kinematicState;
+    const TileCollisionGrid* collisionGrid = nullptr;
+    bool dropThroughRequested = false;
 
     void createBody();
-    void loadIdleAnimation();
-    void loadWalkingAnimation();
-    void loadJumpingAnimation();
-    void loadFallingAnimation();
-    void loadLandingAnimation();
+    auto findAnimation(const std::string& name) -> Animation*;
     void flipAnimation(bool faceRight);
     void updateDebugWindow();
     void displayCurrentAnimationInfo();
     void applyMovement(float deltaTime);
+    void applyKinematicMovement(float deltaTime);
+    void updateFacing();
     void updateDebugColor();
     SDL_Color interpolateColor(const SDL_Color& startColor, const SDL_Color& endColor, float t);
 };
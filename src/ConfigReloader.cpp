@@ -0,0 +1,171 @@
+#include "ConfigReloader.h"
+#include "AssetFileSystem.h"
+#include "Logging.h"
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+auto readChangedFile(const std::string& path, std::string& contents) -> bool {
+    if (!AssetFileSystem::readLooseText(path, contents)) {
+        getLogger(LogSubsystem::Assets)->warn("Ignoring change to {}: file could not be read", path);
+        return false;
+    }
+    return true;
+}
+
+void diffNumber(float previous, float next, std::optional<float>& out) {
+    if (previous != next) {
+        out = next;
+    }
+}
+
+} // namespace
+
+ConfigReloader::ConfigReloader(ConfigReloadPaths paths, const AppConfig& config, const CharacterConfig& characterConfig)
+    : paths(std::move(paths)), config(config), characterConfig(characterConfig) {
+    watcher.addFile(this->paths.config);
+    watcher.addFile(this->paths.characterConfig);
+    watcher.addFile(this->paths.level);
+    watchSpriteSheets();
+    thread = std::thread(&ConfigReloader::run, this);
+}
+
+ConfigReloader::~ConfigReloader() {
+    stopRequested.store(true);
+    watcher.wake();
+    thread.join();
+}
+
+auto ConfigReloader::takeReloads() -> std::vector<ConfigReload> {
+    if (!hasReady.load(std::memory_order_acquire)) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(readyMutex);
+    hasReady.store(false, std::memory_order_relaxed);
+    return std::exchange(ready, {});
+}
+
+void ConfigReloader::run() {
+    while (!stopRequested.load()) {
+        for (const std::string& path : watcher.waitForChanges(WAIT_TIMEOUT)) {
+            ConfigReload reload;
+            reload.path = path;
+            bool valid = false;
+            if (path == paths.config) {
+                valid = reloadConfig(reload);
+            } else if (path == paths.characterConfig) {
+                valid = reloadCharacterConfig(reload);
+            } else if (path == paths.level) {
+                valid = reloadLevel(reload);
+            } else {
+                valid = reloadSpriteSheet(reload);
+            }
+            if (!valid || reload.isEmpty()) {
+                continue;
+            }
+
+            getLogger(LogSubsystem::Assets)->info("Reloaded {}", path);
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+                ready.push_back(std::move(reload));
+            }
+            hasReady.store(true, std::memory_order_release);
+        }
+    }
+}
+
+void ConfigReloader::watchSpriteSheets() {
+    for (const AnimationConfig& animation : characterConfig.animations) {
+        watcher.addFile(animation.filePath);
+    }
+}
+
+auto ConfigReloader::reloadConfig(ConfigReload& reload) -> bool {
+    std::string contents;
+    AppConfig next;
+    std::string error;
+    if (!readChangedFile(reload.path, contents)) {
+        return false;
+    }
+    if (!ConfigLoader::parseAppConfig(contents, next, error)) {
+        getLogger(LogSubsystem::Assets)->warn("Ignoring change to {}: {}", reload.path, error);
+        return false;
+    }
+    diffNumber(config.maxWalkingSpeed, next.maxWalkingSpeed, reload.maxWalkingSpeed);
+    if (next.stepGovernor != config.stepGovernor) {
+        reload.stepGovernor = next.stepGovernor;
+    }
+    config = std::move(next);
+    return true;
+}
+
+auto ConfigReloader::reloadCharacterConfig(ConfigReload& reload) -> bool {
+    std::string contents;
+    CharacterConfig next;
+    std::string error;
+    if (!readChangedFile(reload.path, contents)) {
+        return false;
+    }
+    if (!ConfigLoader::parseCharacterConfig(contents, next, error)) {
+        getLogger(LogSubsystem::Assets)->warn("Ignoring change to {}: {}", reload.path, error);
+        return false;
+    }
+
+    diffNumber(characterConfig.groundAcceleration, next.groundAcceleration, reload.groundAcceleration);
+    diffNumber(characterConfig.airAcceleration, next.airAcceleration, reload.airAcceleration);
+    diffNumber(characterConfig.maxWalkingSpeed, next.maxWalkingSpeed, reload.maxWalkingSpeed);
+    diffNumber(characterConfig.jumpStrength, next.jumpStrength, reload.jumpStrength);
+    if (next.controller != characterConfig.controller) {
+        getLogger(LogSubsystem::Assets)->warn("{}: a controller change takes effect on restart", reload.path);
+    }
+
+    // Only animations whose entry changed are cut again
+    for (const AnimationConfig& animation : next.animations) {
+        const auto& previousAnimations = characterConfig.animations;
+        auto previous = std::find_if(previousAnimations.begin(), previousAnimations.end(), [&](const AnimationConfig& entry) {
+            return entry.name == animation.name;
+        });
+        if ((previous == previousAnimations.end() || *previous != animation) && !sliceFromDisk(animation, reload.animations)) {
+            return false;
+        }
+    }
+
+    characterConfig = std::move(next);
+    watchSpriteSheets();
+    return true;
+}
+
+auto ConfigReloader::reloadSpriteSheet(ConfigReload& reload) -> bool {
+    for (const AnimationConfig& animation : characterConfig.animations) {
+        if (animation.filePath == reload.path && !sliceFromDisk(animation, reload.animations)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto ConfigReloader::reloadLevel(ConfigReload& reload) -> bool {
+    std::string contents;
+    TilemapData map;
+    std::string error = "file could not be read";
+    if (!AssetFileSystem::readLooseText(reload.path, contents) || !Level::parseTilemap(contents, map, error)) {
+        getLogger(LogSubsystem::Assets)->warn("Ignoring change to {}: {}", reload.path, error);
+        return false;
+    }
+    reload.tilemap = std::move(map);
+    return true;
+}
+
+auto ConfigReloader::sliceFromDisk(const AnimationConfig& animation, std::vector<AnimationFrames>& out) -> bool {
+    SurfacePtr sheet(IMG_Load(animation.filePath.c_str()));
+    if (sheet == nullptr) {
+        getLogger(LogSubsystem::Assets)->warn("Ignoring change to {}: {}", animation.filePath, SDL_GetError());
+        return false;
+    }
+    for (AnimationFrames& frames : Character::sliceAnimations(animation, sheet.get())) {
+        out.push_back(std::move(frames));
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Character.h"
+#include "FileWatcher.h"
+#include "GameConfig.h"
+#include "Level.h"
+
+// What changed in one edited file, parsed and validated on the reload thread.
+// Only the parts that differ from the previous version are set.
+struct ConfigReload {
+    std::string path;
+    std::optional<float> maxWalkingSpeed;
+    std::optional<float> groundAcceleration;
+    std::optional<float> airAcceleration;
+    std::optional<float> jumpStrength;
+    std::optional<StepGovernorConfig> stepGovernor;
+    std::vector<AnimationFrames> animations; // Re-sliced, waiting for texture upload
+    std::optional<TilemapData> tilemap;
+
+    [[nodiscard]] auto isEmpty() const -> bool {
+        return !maxWalkingSpeed && !groundAcceleration && !airAcceleration && !jumpStrength && !stepGovernor && animations.empty() && !tilemap;
+    }
+};
+
+struct ConfigReloadPaths {
+    std::string config;          // config.json
+    std::string characterConfig; // character_config.json; its sprite sheets are watched too
+    std::string level;           // The loaded .tmj
+};
+
+// Hot reload for development. A background thread waits on a FileWatcher,
+// re-reads edited files from disk (bypassing any mounted pack), validates
+// them and diffs them against the previous version. Invalid edits are logged
+// and skipped, so a half-saved file never reaches the game.
+class ConfigReloader {
+public:
+    // The configs the game started with are the baseline for the first diff
+    ConfigReloader(ConfigReloadPaths paths, const AppConfig& config, const CharacterConfig& characterConfig);
+    ~ConfigReloader();
+
+    ConfigReloader(const ConfigReloader&) = delete;
+    auto operator=(const ConfigReloader&) -> ConfigReloader& = delete;
+
+    // Main thread, once per tick. Only takes the lock when a reload is waiting.
+    auto takeReloads() -> std::vector<ConfigReload>;
+
+    static constexpr std::chrono::milliseconds WAIT_TIMEOUT{500};
+
+private:
+    void run();
+    void watchSpriteSheets();
+    auto reloadConfig(ConfigReload& reload) -> bool;
+    auto reloadCharacterConfig(ConfigReload& reload) -> bool;
+    auto reloadSpriteSheet(ConfigReload& reload) -> bool;
+    auto reloadLevel(ConfigReload& reload) -> bool;
+    static auto sliceFromDisk(const AnimationConfig& animation, std::vector<AnimationFrames>& out) -> bool;
+
+    ConfigReloadPaths paths;
+    // Last accepted versions; only the reload thread touches these once it runs
+    AppConfig config;
+    CharacterConfig characterConfig;
+
+    FileWatcher watcher;
+    std::mutex readyMutex;
+    std::vector<ConfigReload> ready;
+    std::atomic<bool> hasReady{false};
+    std::atomic<bool> stopRequested{false};
+    std::thread thread; // Declared last so everything above exists before it starts
+};
@@ -0,0 +1,129 @@
+#include "ControlProtocol.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+void ControlPayloadWriter::writeRaw(const void* data, size_t size) {
+    const auto* raw = static_cast<const uint8_t*>(data);
+    bytes.insert(bytes.end(), raw, raw + size);
+}
+
+void ControlPayloadWriter::writeString(std::string_view value) {
+    const size_t length = std::min<size_t>(value.size(), UINT8_MAX);
+    writeU8(static_cast<uint8_t>(length));
+    writeRaw(value.data(), length);
+}
+
+void ControlPayloadWriter::writeValue(const ControlValue& value) {
+    writeU8(static_cast<uint8_t>(value.index()));
+    std::visit([this](auto typed) {
+        if constexpr (std::is_same_v<decltype(typed), bool>) {
+            const int32_t flag = typed ? 1 : 0;
+            writeRaw(&flag, sizeof(flag));
+        } else {
+            writeRaw(&typed, sizeof(typed));
+        }
+    }, value);
+}
+
+void ControlPayloadWriter::writeTelemetry(const TelemetrySample& sample) {
+    writeU64(sample.tick);
+    writeFloat(sample.x);
+    writeFloat(sample.y);
+    writeFloat(sample.velocityX);
+    writeFloat(sample.velocityY);
+    writeU8(sample.grounded ? 1 : 0);
+    writeFloat(sample.frameMs);
+    writeFloat(sample.simMs);
+}
+
+auto ControlPayloadReader::readRaw(void* data, size_t size) -> bool {
+    if (failed || payload.size() - offset < size) {
+        failed = true;
+        std::memset(data, 0, size);
+        return false;
+    }
+    std::memcpy(data, payload.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+auto ControlPayloadReader::readU8() -> uint8_t {
+    uint8_t value = 0;
+    readRaw(&value, sizeof(value));
+    return value;
+}
+
+auto ControlPayloadReader::readU64() -> uint64_t {
+    uint64_t value = 0;
+    readRaw(&value, sizeof(value));
+    return value;
+}
+
+auto ControlPayloadReader::readFloat() -> float {
+    float value = 0.0f;
+    readRaw(&value, sizeof(value));
+    return value;
+}
+
+auto ControlPayloadReader::readString() -> std::string {
+    std::string value(readU8(), '\0');
+    readRaw(value.data(), value.size());
+    return value;
+}
+
+auto ControlPayloadReader::readValue() -> ControlValue {
+    const uint8_t index = readU8();
+    int32_t bits = 0;
+    readRaw(&bits, sizeof(bits));
+    switch (index) {
+        case 0:
+            return bits != 0;
+        case 1:
+            return bits;
+        case 2: {
+            float value = 0.0f;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        default:
+            failed = true;
+            return false;
+    }
+}
+
+auto ControlPayloadReader::readTelemetry() -> TelemetrySample {
+    TelemetrySample sample;
+    sample.tick = readU64();
+    sample.x = readFloat();
+    sample.y = readFloat();
+    sample.velocityX = readFloat();
+    sample.velocityY = readFloat();
+    sample.grounded = readU8() != 0;
+    sample.frameMs = readFloat();
+    sample.simMs = readFloat();
+    return sample;
+}
+
+void ControlProtocol::appendFrame(std::vector<uint8_t>& out, ControlMessage type, std::span<const uint8_t> payload) {
+    const auto length = static_cast<uint16_t>(std::min(payload.size(), MAX_PAYLOAD_SIZE));
+    const auto* lengthBytes = reinterpret_cast<const uint8_t*>(&length);
+    out.insert(out.end(), lengthBytes, lengthBytes + sizeof(length));
+    out.push_back(static_cast<uint8_t>(type));
+    out.insert(out.end(), payload.begin(), payload.begin() + length);
+}
+
+auto ControlProtocol::takeFrame(std::vector<uint8_t>& buffer, ControlFrame& frame) -> bool {
+    if (buffer.size() < HEADER_SIZE) {
+        return false;
+    }
+    uint16_t length = 0;
+    std::memcpy(&length, buffer.data(), sizeof(length));
+    if (buffer.size() < HEADER_SIZE + length) {
+        return false;
+    }
+    frame.type = static_cast<ControlMessage>(buffer[2]);
+    frame.payload.assign(buffer.begin() + HEADER_SIZE, buffer.begin() + HEADER_SIZE + length);
+    buffer.erase(buffer.begin(), buffer.begin() + HEADER_SIZE + length);
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// Wire format of the local control socket, shared by the game (ControlServer)
+// and tools/ControlClient.cpp. Every message is a frame:
+//   uint16 payload length, uint8 ControlMessage, payload
+// Integers and floats are in host byte order, since both ends run on the same machine.
+// Strings are a uint8 length followed by the bytes; values are a uint8
+// variant index (0 bool, 1 int, 2 float) followed by 4 bytes.
+
+enum class ControlMessage : uint8_t {
+    // Client to game
+    ListSettings = 1, // No payload; answered with one Setting per registered setting, then Ok
+    GetSetting = 2,   // key
+    SetSetting = 3,   // key, value; answered with the stored (clamped) value
+    ReloadLevel = 4,  // No payload; answered with Ok or Error once the level is rebuilt
+    Subscribe = 5,    // uint8 0/1; turns the Telemetry stream off/on
+    // Game to client
+    Setting = 64,     // key, value
+    Ok = 65,
+    Error = 66,       // message
+    Telemetry = 67,   // TelemetrySample
+};
+
+// Same alternatives and order as SettingValue
+using ControlValue = std::variant<bool, int32_t, float>;
+
+// One simulation tick of the player character
+struct TelemetrySample {
+    uint64_t tick = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+    bool grounded = false;
+    float frameMs = 0.0f; // Previous frame
+    float simMs = 0.0f;   // Previous frame's physics and character update
+
+    static constexpr size_t ENCODED_SIZE = 33;
+};
+
+struct ControlFrame {
+    ControlMessage type{};
+    std::vector<uint8_t> payload;
+};
+
+class ControlPayloadWriter {
+public:
+    void writeU8(uint8_t value) { bytes.push_back(value); }
+    void writeU64(uint64_t value) { writeRaw(&value, sizeof(value)); }
+    void writeFloat(float value) { writeRaw(&value, sizeof(value)); }
+    // Longer strings are truncated to 255 bytes
+    void writeString(std::string_view value);
+    void writeValue(const ControlValue& value);
+    void writeTelemetry(const TelemetrySample& sample);
+
+    std::vector<uint8_t> bytes;
+
+private:
+    void writeRaw(const void* data, size_t size);
+};
+
+// Bounds-checked; any read past the end makes ok() false and returns zeros
+class ControlPayloadReader {
+public:
+    explicit ControlPayloadReader(std::span<const uint8_t> payload) : payload(payload) {}
+
+    auto readU8() -> uint8_t;
+    auto readU64() -> uint64_t;
+    auto readFloat() -> float;
+    auto readString() -> std::string;
+    auto readValue() -> ControlValue;
+    auto readTelemetry() -> TelemetrySample;
+
+    // True if every read succeeded and the whole payload was consumed
+    [[nodiscard]] auto ok() const -> bool { return !failed && offset == payload.size(); }
+
+private:
+    auto readRaw(void* data, size_t size) -> bool;
+
+    std::span<const uint8_t> payload;
+    size_t offset = 0;
+    bool failed = false;
+};
+
+class ControlProtocol {
+public:
+    static constexpr size_t HEADER_SIZE = 3;
+    static constexpr size_t MAX_PAYLOAD_SIZE = UINT16_MAX;
+
+    // Appends a framed message to out
+    static void appendFrame(std::vector<uint8_t>& out, ControlMessage type, std::span<const uint8_t> payload = {});
+    // Moves the first complete frame out of buffer; false if more bytes are needed
+    static auto takeFrame(std::vector<uint8_t>& buffer, ControlFrame& frame) -> bool;
+};
@@ -0,0 +1,301 @@
+#include "ControlServer.h"
+#include "DeveloperMenu.h"
+#include "Logging.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PLATFORMER_UNIX_SOCKETS
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::is_same_v<ControlValue, SettingValue>, "ControlValue must mirror SettingValue");
+
+namespace {
+
+#ifdef PLATFORMER_UNIX_SOCKETS
+auto setNonBlocking(int fd) -> bool {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 && fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL; // A vanished client must not raise SIGPIPE
+#else
+constexpr int SEND_FLAGS = 0;            // SO_NOSIGPIPE is set per socket instead
+#endif
+#endif
+
+auto findSetting(const std::string& key) -> const SettingInfo* {
+    auto match = std::find_if(SETTING_INFO.begin(), SETTING_INFO.end(), [&](const SettingInfo& info) { return key == info.key; });
+    return match == SETTING_INFO.end() ? nullptr : &*match;
+}
+
+// Scripts may send any numeric type; convert it to the setting's own type
+auto convertValue(const ControlValue& value, const SettingValue& like) -> SettingValue {
+    return std::visit([&](auto target) -> SettingValue {
+        using T = decltype(target);
+        return std::visit([](auto source) { return SettingValue(std::in_place_type<T>, static_cast<T>(source)); }, value);
+    }, like);
+}
+
+// NaN passes through std::clamp, and converting it to int is undefined
+auto isFinite(const ControlValue& value) -> bool {
+    const float* number = std::get_if<float>(&value);
+    return number == nullptr || std::isfinite(*number);
+}
+
+} // namespace
+
+ControlServer::ControlServer(std::string socketPath) : socketPath(std::move(socketPath)) {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (this->socketPath.empty() || this->socketPath.size() >= sizeof(address.sun_path)) {
+        getLogger(LogSubsystem::Game)->error("Control socket path '{}' is empty or too long", this->socketPath);
+        return;
+    }
+    std::memcpy(address.sun_path, this->socketPath.c_str(), this->socketPath.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || !setNonBlocking(listenFd)) {
+        getLogger(LogSubsystem::Game)->error("Cannot create control socket: {}", std::strerror(errno));
+        if (listenFd >= 0) {
+            close(listenFd);
+            listenFd = -1;
+        }
+        return;
+    }
+    unlink(this->socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, static_cast<int>(MAX_CLIENTS)) != 0) {
+        getLogger(LogSubsystem::Game)->error("Cannot listen on {}: {}", this->socketPath, std::strerror(errno));
+        close(listenFd);
+        listenFd = -1;
+        return;
+    }
+    getLogger(LogSubsystem::Game)->info("Control socket listening on {}", this->socketPath);
+#else
+    getLogger(LogSubsystem::Game)->warn("Control sockets are not supported on this platform");
+#endif
+}
+
+ControlServer::~ControlServer() {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    for (Client& client : clients) {
+        close(client.fd);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+#endif
+}
+
+auto ControlServer::poll(DeveloperMenu& menu) -> bool {
+    if (!isListening()) {
+        return false;
+    }
+    acceptClients();
+
+    bool reloadRequested = false;
+    ControlFrame frame;
+    for (Client& client : clients) {
+        readClient(client);
+        while (!client.closed && ControlProtocol::takeFrame(client.input, frame)) {
+            reloadRequested = handleFrame(client, frame, menu) || reloadRequested;
+        }
+        flush(client);
+    }
+    removeClosedClients();
+    return reloadRequested;
+}
+
+void ControlServer::finishLevelReload(bool succeeded, std::string_view error) {
+    for (Client& client : clients) {
+        if (!client.reloadPending) {
+            continue;
+        }
+        client.reloadPending = false;
+        if (succeeded) {
+            send(client, ControlMessage::Ok);
+        } else {
+            sendError(client, error);
+        }
+        flush(client);
+    }
+    removeClosedClients();
+}
+
+auto ControlServer::hasSubscribers() const -> bool {
+    return std::any_of(clients.begin(), clients.end(), [](const Client& client) { return client.subscribed; });
+}
+
+void ControlServer::publishTelemetry(const TelemetrySample& sample) {
+    if (!hasSubscribers()) {
+        return;
+    }
+    ControlPayloadWriter payload;
+    payload.writeTelemetry(sample);
+    for (Client& client : clients) {
+        if (client.subscribed && client.output.size() < MAX_PENDING_TELEMETRY) {
+            send(client, ControlMessage::Telemetry, payload.bytes);
+            flush(client);
+        }
+    }
+    removeClosedClients();
+}
+
+void ControlServer::acceptClients() {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    while (true) {
+        const int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                getLogger(LogSubsystem::Game)->warn("Control socket accept failed: {}", std::strerror(errno));
+            }
+            return;
+        }
+        if (clients.size() >= MAX_CLIENTS || !setNonBlocking(fd)) {
+            getLogger(LogSubsystem::Game)->warn("Rejecting control client ({} connected)", clients.size());
+            close(fd);
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        const int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        Client& client = clients.emplace_back();
+        client.fd = fd;
+        getLogger(LogSubsystem::Game)->info("Control client connected");
+    }
+#endif
+}
+
+void ControlServer::readClient(Client& client) {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    std::array<uint8_t, 4096> buffer{};
+    while (!client.closed) {
+        const ssize_t received = recv(client.fd, buffer.data(), buffer.size(), 0);
+        if (received > 0) {
+            client.input.insert(client.input.end(), buffer.begin(), buffer.begin() + received);
+            // Larger than any valid frame, so the stream is garbage
+            if (client.input.size() > ControlProtocol::HEADER_SIZE + ControlProtocol::MAX_PAYLOAD_SIZE) {
+                client.closed = true;
+            }
+        } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            client.closed = true;
+        } else if (errno != EINTR) {
+            return;
+        }
+    }
+#endif
+}
+
+auto ControlServer::handleFrame(Client& client, const ControlFrame& frame, DeveloperMenu& menu) -> bool {
+    ControlPayloadReader reader(frame.payload);
+    switch (frame.type) {
+        case ControlMessage::ListSettings:
+            for (size_t i = 0; i < SETTING_COUNT; ++i) {
+                sendSetting(client, menu, i);
+            }
+            send(client, ControlMessage::Ok);
+            return false;
+        case ControlMessage::GetSetting:
+        case ControlMessage::SetSetting: {
+            const std::string key = reader.readString();
+            const ControlValue value = frame.type == ControlMessage::SetSetting ? reader.readValue() : ControlValue{};
+            const SettingInfo* info = findSetting(key);
+            if (!reader.ok()) {
+                sendError(client, "malformed request");
+            } else if (info == nullptr) {
+                sendError(client, "unknown setting '" + key + "'");
+            } else if (!isFinite(value)) {
+                sendError(client, "value must be finite");
+            } else {
+                if (frame.type == ControlMessage::SetSetting) {
+                    menu.setSetting(info->id, convertValue(value, info->defaultValue));
+                }
+                sendSetting(client, menu, static_cast<size_t>(info->id));
+            }
+            return false;
+        }
+        case ControlMessage::ReloadLevel:
+            client.reloadPending = true;
+            return true;
+        case ControlMessage::Subscribe: {
+            const bool subscribe = reader.readU8() != 0;
+            if (!reader.ok()) {
+                sendError(client, "malformed request");
+                return false;
+            }
+            client.subscribed = subscribe;
+            send(client, ControlMessage::Ok);
+            return false;
+        }
+        default:
+            sendError(client, "unknown message");
+            return false;
+    }
+}
+
+void ControlServer::send(Client& client, ControlMessage type, std::span<const uint8_t> payload) {
+    ControlProtocol::appendFrame(client.output, type, payload);
+    if (client.output.size() > MAX_PENDING_OUTPUT) {
+        getLogger(LogSubsystem::Game)->warn("Control client is not reading its replies, disconnecting");
+        client.closed = true;
+    }
+}
+
+void ControlServer::sendError(Client& client, std::string_view message) {
+    ControlPayloadWriter payload;
+    payload.writeString(message);
+    send(client, ControlMessage::Error, payload.bytes);
+}
+
+void ControlServer::sendSetting(Client& client, DeveloperMenu& menu, size_t index) {
+    ControlPayloadWriter payload;
+    payload.writeString(SETTING_INFO[index].key);
+    payload.writeValue(menu.getSettings().getValue(SETTING_INFO[index].id));
+    send(client, ControlMessage::Setting, payload.bytes);
+}
+
+void ControlServer::flush(Client& client) {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    size_t written = 0;
+    while (!client.closed && written < client.output.size()) {
+        const ssize_t sent = ::send(client.fd, client.output.data() + written, client.output.size() - written, SEND_FLAGS);
+        if (sent > 0) {
+            written += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break; // Socket buffer full; the rest goes out on a later frame
+        } else {
+            client.closed = true;
+        }
+    }
+    client.output.erase(client.output.begin(), client.output.begin() + static_cast<std::ptrdiff_t>(written));
+#endif
+}
+
+void ControlServer::removeClosedClients() {
+#ifdef PLATFORMER_UNIX_SOCKETS
+    auto closed = std::remove_if(clients.begin(), clients.end(), [](const Client& client) {
+        if (client.closed) {
+            close(client.fd);
+            getLogger(LogSubsystem::Game)->info("Control client disconnected");
+        }
+        return client.closed;
+    });
+    clients.erase(closed, clients.end());
+#endif
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ControlProtocol.h"
+
+class DeveloperMenu;
+
+// Local control channel for scripts (see ControlProtocol.h and
+// tools/ControlClient.cpp). Listens on a Unix domain socket; everything is
+// non-blocking and driven by poll() once per frame, so a slow or stuck client
+// never stalls the game.
+class ControlServer {
+public:
+    // Replaces a stale socket file left at socketPath by an earlier run
+    explicit ControlServer(std::string socketPath);
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    auto operator=(const ControlServer&) -> ControlServer& = delete;
+
+    [[nodiscard]] auto isListening() const -> bool { return listenFd >= 0; }
+
+    // Accepts clients and answers their requests. Settings are written through
+    // the menu, so observers get them with the next batch. Returns true when a
+    // client asked for a level reload; report the outcome with finishLevelReload().
+    auto poll(DeveloperMenu& menu) -> bool;
+    void finishLevelReload(bool succeeded, std::string_view error);
+
+    [[nodiscard]] auto hasSubscribers() const -> bool;
+    // Sends the sample to every subscribed client that is keeping up
+    void publishTelemetry(const TelemetrySample& sample);
+
+    static constexpr size_t MAX_CLIENTS = 8;
+    // Telemetry is dropped for a client this far behind; replies are not
+    static constexpr size_t MAX_PENDING_TELEMETRY = 64 * 1024;
+    // A client that stops reading its replies altogether is disconnected
+    static constexpr size_t MAX_PENDING_OUTPUT = 1024 * 1024;
+
+private:
+    struct Client {
+        int fd = -1;
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+        bool subscribed = false;
+        bool reloadPending = false;
+        bool closed = false;
+    };
+
+    void acceptClients();
+    void readClient(Client& client);
+    auto handleFrame(Client& client, const ControlFrame& frame, DeveloperMenu& menu) -> bool;
+    void send(Client& client, ControlMessage type, std::span<const uint8_t> payload = {});
+    void sendError(Client& client, std::string_view message);
+    void sendSetting(Client& client, DeveloperMenu& menu, size_t index);
+    void flush(Client& client);
+    void removeClosedClients();
+
+    std::string socketPath;
+    int listenFd = -1;
+    std::vector<Client> clients;
+};
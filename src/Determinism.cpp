@@ -0,0 +1,80 @@
+#include "Determinism.h"
+#include "WorldSnapshot.h"
+#include <bit>
+#include <iomanip>
+
+namespace {
+
+class Hasher {
+public:
+    void add(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFFU;
+            hash *= 1099511628211ULL;
+        }
+    }
+    void add(float value) { add(std::bit_cast<uint32_t>(value)); }
+    void add(int32_t value) { add(static_cast<uint32_t>(value)); }
+    void add(bool value) { add(static_cast<uint32_t>(value ? 1 : 0)); }
+    void add(b2Vec2 value) {
+        add(value.x);
+        add(value.y);
+    }
+
+    [[nodiscard]] auto get() const -> uint64_t { return hash; }
+
+private:
+    uint64_t hash = 14695981039346656037ULL;
+};
+
+} // namespace
+
+void Determinism::configureWorld(b2WorldDef& worldDef) {
+    worldDef.workerCount = 1;
+    worldDef.enqueueTask = nullptr;
+    worldDef.finishTask = nullptr;
+}
+
+auto Determinism::hash(const WorldSnapshot& snapshot) -> uint64_t {
+    Hasher hasher;
+    // Fields one by one, since the structs have padding
+    for (const BodySnapshot& body : snapshot.bodies) {
+        hasher.add(body.transform.p);
+        hasher.add(body.transform.q.c);
+        hasher.add(body.transform.q.s);
+        hasher.add(body.linearVelocity);
+        hasher.add(body.angularVelocity);
+        hasher.add(body.awake);
+    }
+    for (const CharacterSnapshot& character : snapshot.characters) {
+        hasher.add(character.position);
+        hasher.add(character.kinematicState.position);
+        hasher.add(character.kinematicState.velocity);
+        hasher.add(character.kinematicState.grounded);
+        hasher.add(static_cast<int32_t>(character.animation.frameIndex));
+        hasher.add(character.animation.time);
+        hasher.add(character.animation.completed);
+        hasher.add(character.elapsedTime);
+        hasher.add(character.timeSinceLastGroundContact);
+        hasher.add(character.jumpCooldownTimer);
+        hasher.add(static_cast<uint32_t>(character.jumpBufferTicks));
+        hasher.add(static_cast<uint32_t>(character.coyoteTicks));
+        hasher.add(static_cast<uint32_t>(character.animationIndex));
+        hasher.add(character.isOnGround);
+        hasher.add(character.wasOnGround);
+        hasher.add(character.isFacingRight);
+    }
+    return hasher.get();
+}
+
+void Determinism::writeCsvHeader(std::ostream& out) {
+    out << "tick,hash\n";
+}
+
+void Determinism::writeCsvRow(std::ostream& out, uint64_t tick, uint64_t hash) {
+    const std::ios::fmtflags flags = out.flags();
+    const char fill = out.fill();
+    out << tick << ',' << std::hex << std::setw(16) << std::setfill('0') << hash << '\n';
+    out.flags(flags);
+    out.fill(fill);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <ostream>
+
+struct WorldSnapshot;
+
+// Settings for runs that must reproduce bit for bit across builds, so a replay
+// recorded with a Release GCC build can be checked against a Debug Clang one.
+// Reproducibility rests on two things: the DETERMINISTIC_MATH CMake option,
+// which disables floating-point contraction so float math rounds the same in
+// every build, and a single-threaded step.
+class Determinism {
+public:
+    // Box2D solves on the stepping thread with a single worker and no task callbacks.
+    // These are b2DefaultWorldDef's values; they are set explicitly so a threaded default cannot slip in.
+    static void configureWorld(b2WorldDef& worldDef);
+
+    // FNV-1a over the bit pattern of every value in the snapshot
+    [[nodiscard]] static auto hash(const WorldSnapshot& snapshot) -> uint64_t;
+
+    // One "tick,hash" row per simulated tick; diff two files to find the first divergent tick
+    static void writeCsvHeader(std::ostream& out);
+    static void writeCsvRow(std::ostream& out, uint64_t tick, uint64_t hash);
+};
@@ -1,42 +1,24 @@
 #include "DeveloperMenu.h"
+#include "GameConfig.h"
+#include <nlohmann/json.hpp>
 #include <fstream>
 #include <SDL3/SDL_video.h>
 #include <iostream>
 #include "Logging.h"
+#include "Profiler.h"
+#include "FramePacer.h"
+#include "FrameStats.h"
+#include "PhysicsStats.h"
+#include "StepGovernor.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <functional>
 
-DeveloperMenu::DeveloperMenu(const nlohmann::json& initialSettings)
-    : isVisible(false),
-      gravity(9.8f),
-      characterSpeed(5.0f),
-      prevGravity(9.8f),
-      prevCharacterSpeed(5.0f),
-      jumpStrength(initialSettings.value("jumpStrength", 10.0f)),
-      minJumpHeight(initialSettings.value("minJumpHeight", 1.0f)),
-      maxJumpHeight(initialSettings.value("maxJumpHeight", 5.0f)),
-      jumpCooldownDuration(initialSettings.value("jumpCooldownDuration", 0.5f)),
-      prevJumpStrength(jumpStrength),
-      prevMinJumpHeight(minJumpHeight),
-      prevMaxJumpHeight(maxJumpHeight),
-      prevJumpCooldownDuration(jumpCooldownDuration),
-      groundAcceleration(initialSettings.value("groundAcceleration", 10.0f)),
-      airAcceleration(initialSettings.value("airAcceleration", 5.0f)),
-      maxWalkingSpeed(initialSettings.value("maxWalkingSpeed", 7.0f)),
-      prevGroundAcceleration(groundAcceleration),
-      prevAirAcceleration(airAcceleration),
-      prevMaxWalkingSpeed(maxWalkingSpeed),
-      showDebugVisualizations(false),
-      showContactPoints(false),
-      showForceVisualizations(false),
-      maxContactPoints(initialSettings.value("maxContactPoints", 10)),
-      enableBox2DDebugDraw(initialSettings.value("enableBox2DDebugDraw", false)),
-      drawShapes(initialSettings.value("drawShapes", true)),
-      drawJoints(initialSettings.value("drawJoints", true)),
-      drawAABBs(initialSettings.value("drawAABBs", false)),
-      drawContactPoints(initialSettings.value("drawContactPoints", false)),
-      drawContactNormals(initialSettings.value("drawContactNormals", false)),
-      drawContactImpulses(initialSettings.value("drawContactImpulses", false)),
-      drawFrictionImpulses(initialSettings.value("drawFrictionImpulses", false)) {
-    loadSettings();
+DeveloperMenu::DeveloperMenu(std::span<const SettingDelta> initialSettings)
+    : isVisible(false) {
+    settings.apply(initialSettings);
 }
 
 DeveloperMenu::~DeveloperMenu() {
@@ -63,153 +45,271 @@ void DeveloperMenu::render() {
     ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_FirstUseEver);
 
     ImGui::Begin("Developer Menu");
-    ImGui::Text("Gravity: %.2f", gravity);
-    if (ImGui::SliderFloat("Gravity", &gravity, 0.0f, -30.0f)) {
-        notifyObservers("gravity", gravity);
-    }
-    ImGui::Text("Character Speed: %.2f", characterSpeed);
-    if (ImGui::SliderFloat("Character Speed", &characterSpeed, 0.0f, 20.0f)) {
-        notifyObservers("characterSpeed", characterSpeed);
+    for (const SettingInfo& info : SETTING_INFO) {
+        if (info.section == SettingSection::Box2DDebugDraw && !isBox2DDebugDrawEnabled()) {
+            continue;
+        }
+        renderSetting(info);
     }
-    ImGui::Text("Jump Strength: %.2f", jumpStrength);
-    if (ImGui::SliderFloat("Jump Strength", &jumpStrength, 0.0f, 50.0f)) {
-        notifyObservers("jumpStrength", jumpStrength);
+
+    ImGui::End();
+
+    renderProfiler();
+    renderFrameStats();
+    renderPhysicsStats();
+}
+
+void DeveloperMenu::renderSetting(const SettingInfo& info) {
+    SettingValue value = settings.getValue(info.id);
+    bool edited = false;
+    if (auto* flag = std::get_if<bool>(&value)) {
+        edited = ImGui::Checkbox(info.label, flag);
+    } else if (auto* integer = std::get_if<int>(&value)) {
+        ImGui::Text("%s: %d", info.label, *integer);
+        edited = ImGui::SliderInt(info.label, integer, static_cast<int>(info.sliderStart), static_cast<int>(info.sliderEnd));
+    } else if (auto* number = std::get_if<float>(&value)) {
+        ImGui::Text("%s: %.2f", info.label, *number);
+        edited = ImGui::SliderFloat(info.label, number, info.sliderStart, info.sliderEnd);
     }
-    ImGui::Text("Minimum Jump Height: %.2f", minJumpHeight);
-    if (ImGui::SliderFloat("Minimum Jump Height", &minJumpHeight, 0.0f, 10.0f)) {
-        notifyObservers("minJumpHeight", minJumpHeight);
+    if (edited) {
+        settings.set(info.id, value);
     }
-    ImGui::Text("Maximum Jump Height: %.2f", maxJumpHeight);
-    if (ImGui::SliderFloat("Maximum Jump Height", &maxJumpHeight, 0.0f, 20.0f)) {
-        notifyObservers("maxJumpHeight", maxJumpHeight);
+}
+
+void DeveloperMenu::renderPhysicsStats() {
+    if (physicsStats == nullptr || physicsStats->getSampleCount() == 0) return;
+
+    ImGui::SetNextWindowSize(ImVec2(420, 520), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Physics");
+
+    ImGui::Text("Sub-steps: %d  Chain vertices: %zu  Steps: %llu", physicsStats->getSubStepCount(), physicsStats->getChainVertexCount(),
+                static_cast<unsigned long long>(physicsStats->getStepCount()));
+    if (stepGovernor != nullptr) {
+        const StepGovernorConfig& bounds = stepGovernor->getConfig();
+        ImGui::Text("Governor: %s, sub-steps %d-%d, step %.2f / %.2f ms, detail %s", bounds.enabled ? "on" : "off", bounds.minSubSteps,
+                    bounds.maxSubSteps, stepGovernor->getAverageStepMs(), bounds.stepBudgetMs, StepGovernor::toString(stepGovernor->getDetailLevel()));
+        ImGui::Text("Last change: %s (update %llu)", stepGovernor->getLastDecision(), static_cast<unsigned long long>(stepGovernor->getLastDecisionFrame()));
     }
-    ImGui::Text("Jump Cooldown Duration: %.2f", jumpCooldownDuration);
-    if (ImGui::SliderFloat("Jump Cooldown Duration", &jumpCooldownDuration, 0.0f, 5.0f)) {
-        notifyObservers("jumpCooldownDuration", jumpCooldownDuration);
+
+    char overlay[64];
+    for (const auto& metric : PhysicsStats::getTimingMetrics()) {
+        physicsStats->copyHistory(metric, physicsHistory);
+        std::snprintf(overlay, sizeof(overlay), "%.3f ms (avg %.3f)", physicsHistory.back(), physicsStats->average(metric));
+        ImGui::PlotLines(metric.name, physicsHistory.data(), static_cast<int>(physicsHistory.size()), 0, overlay, 0.0f, 3.4e38f,
+                         ImVec2(0, 40));
     }
-    ImGui::Text("Ground Acceleration: %.2f", groundAcceleration);
-    if (ImGui::SliderFloat("Ground Acceleration", &groundAcceleration, 0.0f, 20.0f)) {
-        notifyObservers("groundAcceleration", groundAcceleration);
+
+    if (ImGui::BeginTable("PhysicsCounters", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Counter");
+        ImGui::TableSetupColumn("Current");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableHeadersRow();
+        const PhysicsSample& latest = physicsStats->getSample(0);
+        for (const auto& metric : PhysicsStats::getCounterMetrics()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(metric.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.0f", metric.value(latest));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", physicsStats->average(metric));
+        }
+        ImGui::EndTable();
     }
-    ImGui::Text("Air Acceleration: %.2f", airAcceleration);
-    if (ImGui::SliderFloat("Air Acceleration", &airAcceleration, 0.0f, 20.0f)) {
-        notifyObservers("airAcceleration", airAcceleration);
+
+    ImGui::End();
+}
+
+void DeveloperMenu::renderFrameStats() {
+    if (frameStats == nullptr || frameStats->getFrameTimes().getSampleCount() == 0) return;
+
+    // Histogram range, in buckets, wide enough to show hitches at the detection threshold
+    const float budgetMs = frameStats->getFrameBudgetMs();
+    const auto& buckets = frameStats->getFrameTimes().getBuckets();
+    const size_t shownBuckets = std::min(buckets.size(),
+        static_cast<size_t>(2.0f * FrameStats::HITCH_BUDGET_FACTOR * budgetMs / TimingHistogram::BUCKET_WIDTH_MS));
+
+    ImGui::SetNextWindowSize(ImVec2(460, 380), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Frame Stats");
+
+    if (framePacer != nullptr) {
+        std::array<const char*, FramePacer::MODE_COUNT> modeNames{};
+        for (size_t i = 0; i < modeNames.size(); ++i) {
+            modeNames[i] = FramePacer::toString(static_cast<PacingMode>(i));
+        }
+        int mode = static_cast<int>(framePacer->getMode());
+        if (ImGui::Combo("Pacing", &mode, modeNames.data(), static_cast<int>(modeNames.size()))) {
+            framePacer->setMode(static_cast<PacingMode>(mode));
+        }
+        ImGui::Text("Refresh %.0f Hz, limit %.0f fps, waited %.2f ms before input", framePacer->getRefreshRate(), framePacer->getFrameLimit(),
+                    framePacer->getLastWaitMs());
     }
-    ImGui::Text("Max Walking Speed: %.2f", maxWalkingSpeed);
-    if (ImGui::SliderFloat("Max Walking Speed", &maxWalkingSpeed, 0.0f, 20.0f)) {
-        notifyObservers("maxWalkingSpeed", maxWalkingSpeed);
+
+    if (ImGui::BeginTable("FrameStatsSummary", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableHeadersRow();
+        auto summaryRow = [](const char* label, const TimingSummary& summary) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(label);
+            for (float value : {summary.p50, summary.p95, summary.p99, summary.max, summary.average}) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", value);
+            }
+        };
+        summaryRow("Frame", frameStats->getFrameSummary());
+        summaryRow("Sim tick", frameStats->getSimSummary());
+        if (framePacer != nullptr) {
+            summaryRow("Poll to present", framePacer->getWorkSummary());
+            if (framePacer->getLatency().getSampleCount() > 0) {
+                summaryRow("Input latency", framePacer->getLatencySummary());
+            }
+        }
+        ImGui::EndTable();
     }
-    if (ImGui::Checkbox("Show Debug Visualizations", &showDebugVisualizations)) {
-        notifyObservers("showDebugVisualizations", showDebugVisualizations);
+
+    histogramValues.assign(buckets.begin(), buckets.begin() + static_cast<std::ptrdiff_t>(shownBuckets));
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "0 - %.0f ms, %zu frames", static_cast<float>(shownBuckets) * TimingHistogram::BUCKET_WIDTH_MS,
+                  frameStats->getFrameTimes().getSampleCount());
+    ImGui::PlotHistogram("##FrameHistogram", histogramValues.data(), static_cast<int>(histogramValues.size()), 0, overlay, 0.0f, 3.4e38f,
+                         ImVec2(0, 80));
+
+    if (AllocationTracker::isEnabled()) {
+        const AllocationCounters& allocations = frameStats->getLastFrameAllocations();
+        ImGui::Text("Allocations: %llu (%llu bytes) last frame, peak %llu", static_cast<unsigned long long>(allocations.allocations),
+                    static_cast<unsigned long long>(allocations.bytes), static_cast<unsigned long long>(frameStats->getPeakFrameAllocations()));
     }
-    if (ImGui::Checkbox("Show Contact Points", &showContactPoints)) {
-        notifyObservers("showContactPoints", showContactPoints);
+
+    ImGui::Text("Hitches (> %.1f ms): %llu", FrameStats::HITCH_BUDGET_FACTOR * budgetMs,
+                static_cast<unsigned long long>(frameStats->getHitchCount()));
+    const auto& hitches = frameStats->getHitches();
+    for (auto it = hitches.rbegin(); it != hitches.rend(); ++it) {
+        ImGui::Text("Frame %llu: %.2f ms (sim %.2f ms) %s", static_cast<unsigned long long>(it->frameIndex), it->frameMs, it->simMs,
+                    it->activity.c_str());
     }
-    if (ImGui::Checkbox("Show Force Visualizations", &showForceVisualizations)) {
-        notifyObservers("showForceVisualizations", showForceVisualizations);
+
+    ImGui::End();
+}
+
+void DeveloperMenu::renderProfiler() {
+#ifdef PLATFORMER_PROFILER_ENABLED
+    constexpr float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+    constexpr float TIMELINE_MAX_MS = 2.0f * FRAME_BUDGET_MS;
+    constexpr float HISTORY_HEIGHT = 80.0f;
+    constexpr float ROW_HEIGHT = 18.0f;
+
+    const size_t frameCount = Profiler::getFrameCount();
+    if (frameCount == 0) return;
+
+    auto zoneColor = [](const char* name) -> ImU32 {
+        size_t hash = std::hash<const void*>{}(name);
+        return IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 7) & 0x7F), 80 + ((hash >> 14) & 0x7F), 255);
+    };
+
+    ImGui::SetNextWindowSize(ImVec2(520, 420), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Profiler");
+
+    const ProfileFrame& latest = Profiler::getFrame(0);
+    double latestMs = Profiler::ticksToMilliseconds(latest.end - latest.start);
+    double averageMs = 0.0;
+    for (size_t age = 0; age < frameCount; ++age) {
+        const ProfileFrame& frame = Profiler::getFrame(age);
+        averageMs += Profiler::ticksToMilliseconds(frame.end - frame.start);
     }
-    ImGui::Text("Max Contact Points: %d", maxContactPoints);
-    if (ImGui::SliderInt("Max Contact Points", &maxContactPoints, 1, 100)) {
-        notifyObservers("maxContactPoints", static_cast<float>(maxContactPoints));
+    averageMs /= static_cast<double>(frameCount);
+    ImGui::Text("Frame %llu: %.2f ms (avg %.2f ms over %zu frames)", static_cast<unsigned long long>(latest.index), latestMs, averageMs, frameCount);
+    ImGui::Text("Dropped zones: %llu", static_cast<unsigned long long>(Profiler::getDroppedZoneCount()));
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    // Per-frame stacked bars of top-level zones, oldest on the left
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = ImGui::GetContentRegionAvail().x;
+    float barWidth = width / static_cast<float>(Profiler::HISTORY_SIZE);
+    drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + HISTORY_HEIGHT), IM_COL32(20, 20, 20, 255));
+    for (size_t age = 0; age < frameCount; ++age) {
+        const ProfileFrame& frame = Profiler::getFrame(age);
+        float x = origin.x + width - (static_cast<float>(age + 1) * barWidth);
+        float y = origin.y + HISTORY_HEIGHT;
+        for (const auto& zone : frame.zones) {
+            if (zone.depth != 0) continue;
+            float height = static_cast<float>(Profiler::ticksToMilliseconds(zone.end - zone.start)) / TIMELINE_MAX_MS * HISTORY_HEIGHT;
+            drawList->AddRectFilled(ImVec2(x, std::max(origin.y, y - height)), ImVec2(x + barWidth, y), zoneColor(zone.name));
+            y -= height;
+        }
     }
+    float budgetY = origin.y + HISTORY_HEIGHT - (FRAME_BUDGET_MS / TIMELINE_MAX_MS * HISTORY_HEIGHT);
+    drawList->AddLine(ImVec2(origin.x, budgetY), ImVec2(origin.x + width, budgetY), IM_COL32(255, 80, 80, 255));
+    ImGui::Dummy(ImVec2(width, HISTORY_HEIGHT));
 
-    // Box2D Debug Draw Options
-    if (ImGui::Checkbox("Enable Box2D Debug Draw", &enableBox2DDebugDraw)) {
-        notifyObservers("enableBox2DDebugDraw", enableBox2DDebugDraw);
+    // Nested timeline of the latest frame
+    uint16_t maxDepth = 0;
+    for (const auto& zone : latest.zones) {
+        maxDepth = std::max(maxDepth, zone.depth);
     }
-    if (enableBox2DDebugDraw) {
-        if (ImGui::Checkbox("Draw Shapes", &drawShapes)) {
-            notifyObservers("drawShapes", drawShapes);
-        }
-        if (ImGui::Checkbox("Draw Joints", &drawJoints)) {
-            notifyObservers("drawJoints", drawJoints);
-        }
-        if (ImGui::Checkbox("Draw AABBs", &drawAABBs)) {
-            notifyObservers("drawAABBs", drawAABBs);
-        }
-        if (ImGui::Checkbox("Draw Contact Points", &drawContactPoints)) {
-            notifyObservers("drawContactPoints", drawContactPoints);
-        }
-        if (ImGui::Checkbox("Draw Contact Normals", &drawContactNormals)) {
-            notifyObservers("drawContactNormals", drawContactNormals);
-        }
-        if (ImGui::Checkbox("Draw Contact Impulses", &drawContactImpulses)) {
-            notifyObservers("drawContactImpulses", drawContactImpulses);
+    origin = ImGui::GetCursorScreenPos();
+    float timelineHeight = ROW_HEIGHT * static_cast<float>(maxDepth + 1);
+    double frameTicks = static_cast<double>(std::max<uint64_t>(latest.end - latest.start, 1));
+    drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + timelineHeight), IM_COL32(20, 20, 20, 255));
+    for (const auto& zone : latest.zones) {
+        float x0 = origin.x + static_cast<float>(static_cast<double>(zone.start - latest.start) / frameTicks) * width;
+        float x1 = origin.x + static_cast<float>(static_cast<double>(zone.end - latest.start) / frameTicks) * width;
+        float y0 = origin.y + (ROW_HEIGHT * zone.depth);
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(std::max(x1, x0 + 1.0f), y0 + ROW_HEIGHT - 1.0f), zoneColor(zone.name));
+        drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), zone.name);
+    }
+    ImGui::Dummy(ImVec2(width, timelineHeight));
+
+    // Rolling averages over the history
+    const int columnCount = AllocationTracker::isEnabled() ? 5 : 4;
+    if (ImGui::BeginTable("ProfilerZones", columnCount, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Avg ms/frame");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("Calls");
+        if (AllocationTracker::isEnabled()) {
+            ImGui::TableSetupColumn("Allocs/frame");
         }
-        if (ImGui::Checkbox("Draw Friction Impulses", &drawFrictionImpulses)) {
-            notifyObservers("drawFrictionImpulses", drawFrictionImpulses);
+        ImGui::TableHeadersRow();
+        for (const auto& stats : Profiler::getZoneStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(zoneColor(stats.name)), "%s", stats.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.averageMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.maxMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.calls);
+            if (AllocationTracker::isEnabled()) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stats.allocationsPerFrame);
+            }
         }
+        ImGui::EndTable();
     }
 
     ImGui::End();
+#endif
 }
 
 void DeveloperMenu::handleInput() {
     // Handle input events for the developer menu
 }
 
-void DeveloperMenu::loadSettings() {
-    std::ifstream settingsFile("developer_menu_settings.json");
-    if (settingsFile.is_open()) {
-        settingsFile >> settings;
-        settingsFile.close();
-        gravity = settings.value("gravity", 9.8f);
-        characterSpeed = settings.value("characterSpeed", 5.0f);
-        jumpStrength = settings.value("jumpStrength", 10.0f);
-        jumpCooldownDuration = settings.value("jumpCooldownDuration", 0.5f);
-        groundAcceleration = settings.value("groundAcceleration", 10.0f);
-        airAcceleration = settings.value("airAcceleration", 5.0f);
-        maxWalkingSpeed = settings.value("maxWalkingSpeed", 7.0f);
-        showDebugVisualizations = settings.value("showDebugVisualizations", false);
-        showContactPoints = settings.value("showContactPoints", false);
-        showForceVisualizations = settings.value("showForceVisualizations", false);
-        maxContactPoints = settings.value("maxContactPoints", 10);
-        enableBox2DDebugDraw = settings.value("enableBox2DDebugDraw", false);
-        drawShapes = settings.value("drawShapes", true);
-        drawJoints = settings.value("drawJoints", true);
-        drawAABBs = settings.value("drawAABBs", false);
-        drawContactPoints = settings.value("drawContactPoints", false);
-        drawContactNormals = settings.value("drawContactNormals", false);
-        drawContactImpulses = settings.value("drawContactImpulses", false);
-        drawFrictionImpulses = settings.value("drawFrictionImpulses", false);
-        prevGravity = gravity;
-        prevCharacterSpeed = characterSpeed;
-        prevJumpStrength = jumpStrength;
-        prevMinJumpHeight = minJumpHeight;
-        prevMaxJumpHeight = maxJumpHeight;
-        prevJumpCooldownDuration = jumpCooldownDuration;
-        prevGroundAcceleration = groundAcceleration;
-        prevAirAcceleration = airAcceleration;
-        prevMaxWalkingSpeed = maxWalkingSpeed;
-    } else {
-        spdlog::warn("Failed to open developer_menu_settings.json. Using default settings.");
-    }
-}
-
 void DeveloperMenu::saveSettings() {
-    settings["gravity"] = gravity;
-    settings["characterSpeed"] = characterSpeed;
-    settings["jumpStrength"] = jumpStrength;
-    settings["jumpCooldownDuration"] = jumpCooldownDuration;
-    settings["groundAcceleration"] = groundAcceleration;
-    settings["airAcceleration"] = airAcceleration;
-    settings["maxWalkingSpeed"] = maxWalkingSpeed;
-    settings["showDebugVisualizations"] = showDebugVisualizations;
-    settings["showContactPoints"] = showContactPoints;
-    settings["showForceVisualizations"] = showForceVisualizations;
-    settings["maxContactPoints"] = maxContactPoints;
-    settings["enableBox2DDebugDraw"] = enableBox2DDebugDraw;
-    settings["drawShapes"] = drawShapes;
-    settings["drawJoints"] = drawJoints;
-    settings["drawAABBs"] = drawAABBs;
-    settings["drawContactPoints"] = drawContactPoints;
-    settings["drawContactNormals"] = drawContactNormals;
-    settings["drawContactImpulses"] = drawContactImpulses;
-    settings["drawFrictionImpulses"] = drawFrictionImpulses;
-    std::ofstream settingsFile("developer_menu_settings.json");
-    if (settingsFile.is_open()) {
-        settingsFile << settings.dump(4);
-        settingsFile.close();
+    nlohmann::json settingsFile;
+    settings.save(settingsFile);
+    std::ofstream file(ConfigLoader::DEVELOPER_SETTINGS_PATH);
+    if (file.is_open()) {
+        file << settingsFile.dump(4);
+        file.close();
     } else {
         spdlog::error("Failed to save developer_menu_settings.json.");
     }
@@ -223,30 +323,16 @@ void DeveloperMenu::addObserver(Observer* observer) {
     observers.push_back(observer);
 }
 
-void DeveloperMenu::notifyObservers(const std::string& settingName, float newValue) {
-    for (Observer* observer : observers) {
-        observer->onSettingChanged(settingName, newValue);
-    }
+void DeveloperMenu::notifyAllObservers() {
+    settings.markAllChanged();
 }
 
-void DeveloperMenu::notifyAllObservers() {
-    notifyObservers("gravity", gravity);
-    notifyObservers("characterSpeed", characterSpeed);
-    notifyObservers("jumpStrength", jumpStrength);
-    notifyObservers("jumpCooldownDuration", jumpCooldownDuration);
-    notifyObservers("groundAcceleration", groundAcceleration);
-    notifyObservers("airAcceleration", airAcceleration);
-    notifyObservers("maxWalkingSpeed", maxWalkingSpeed);
-    notifyObservers("showDebugVisualizations", showDebugVisualizations);
-    notifyObservers("showContactPoints", showContactPoints);
-    notifyObservers("showForceVisualizations", showForceVisualizations);
-    notifyObservers("maxContactPoints", static_cast<float>(maxContactPoints));
-    notifyObservers("enableBox2DDebugDraw", enableBox2DDebugDraw);
-    notifyObservers("drawShapes", drawShapes);
-    notifyObservers("drawJoints", drawJoints);
-    notifyObservers("drawAABBs", drawAABBs);
-    notifyObservers("drawContactPoints", drawContactPoints);
-    notifyObservers("drawContactNormals", drawContactNormals);
-    notifyObservers("drawContactImpulses", drawContactImpulses);
-    notifyObservers("drawFrictionImpulses", drawFrictionImpulses);
+void DeveloperMenu::dispatchSettingChanges() {
+    std::span<const SettingDelta> changes = settings.takeChanges();
+    if (changes.empty()) {
+        return;
+    }
+    for (Observer* observer : observers) {
+        observer->onSettingsChanged(changes);
+    }
 }
@@ -1,79 +1,75 @@
 #pragma once
 #include <imgui.h>
-#include <nlohmann/json.hpp>
+#include <span>
 #include <vector>
 #include <string>
 #include <SDL3/SDL.h>
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
 #include "Observer.h"
+#include "Settings.h"
+
+class FramePacer;
+class FrameStats;
+class PhysicsStats;
+class StepGovernor;
 
 class DeveloperMenu {
 public:
-    DeveloperMenu(const nlohmann::json& initialSettings);
+    // Typically GameConfig::developerSettings
+    DeveloperMenu(std::span<const SettingDelta> initialSettings);
     ~DeveloperMenu();
 
     void init(SDL_Window* window, SDL_Renderer* renderer);
     void handleDPIScaling(SDL_Window* window);
     void render();
     void handleInput();
-    void loadSettings();
     void saveSettings();
     void toggleVisibility();
     void addObserver(Observer* observer);
-    void notifyObservers(const std::string& settingName, float newValue);
+    // Sends every setting to the observers with the next batch
     void notifyAllObservers();
+    // Delivers the settings changed since the last call as one batch; call once per tick
+    void dispatchSettingChanges();
+
+    // Frame timing shown in the "Frame Stats" window; not owned
+    void setFrameStats(const FrameStats* stats) { frameStats = stats; }
+    // Box2D step timings and counters shown in the "Physics" window; not owned
+    void setPhysicsStats(const PhysicsStats* stats) { physicsStats = stats; }
+    void setStepGovernor(const StepGovernor* governor) { stepGovernor = governor; }
+    // Pacing mode picker and input latency in the "Frame Stats" window; not owned
+    void setFramePacer(FramePacer* pacer) { framePacer = pacer; }
+
+    [[nodiscard]] auto getSettings() const -> const SettingsRegistry& { return settings; }
+    // Changes a setting from outside the menu, e.g. a reloaded config; observers get it with the next batch
+    void setSetting(SettingId id, SettingValue value) { settings.set(id, value); }
 
     // Public getter methods for Box2D debug draw settings
-    bool isBox2DDebugDrawEnabled() const { return enableBox2DDebugDraw; }
-    bool shouldDrawShapes() const { return drawShapes; }
-    bool shouldDrawJoints() const { return drawJoints; }
-    bool shouldDrawAABBs() const { return drawAABBs; }
-    bool shouldDrawContactPoints() const { return drawContactPoints; }
-    bool shouldDrawContactNormals() const { return drawContactNormals; }
-    bool shouldDrawContactImpulses() const { return drawContactImpulses; }
-    bool shouldDrawFrictionImpulses() const { return drawFrictionImpulses; }
+    bool isBox2DDebugDrawEnabled() const { return settings.get<SettingId::EnableBox2DDebugDraw>(); }
+    bool shouldDrawShapes() const { return settings.get<SettingId::DrawShapes>(); }
+    bool shouldDrawJoints() const { return settings.get<SettingId::DrawJoints>(); }
+    bool shouldDrawAABBs() const { return settings.get<SettingId::DrawAABBs>(); }
+    bool shouldDrawContactPoints() const { return settings.get<SettingId::DrawContactPoints>(); }
+    bool shouldDrawContactNormals() const { return settings.get<SettingId::DrawContactNormals>(); }
+    bool shouldDrawContactImpulses() const { return settings.get<SettingId::DrawContactImpulses>(); }
+    bool shouldDrawFrictionImpulses() const { return settings.get<SettingId::DrawFrictionImpulses>(); }
 
 private:
-    bool isVisible;
-    float gravity;
-    float characterSpeed;
+    void renderSetting(const SettingInfo& info);
+    void renderProfiler();
+    void renderFrameStats();
+    void renderPhysicsStats();
 
-    float prevGravity;
-    float prevCharacterSpeed;
+    bool isVisible;
 
     std::vector<Observer*> observers;
-    nlohmann::json settings;
-
-    float jumpStrength;
-    float minJumpHeight;
-    float maxJumpHeight;
-    float jumpCooldownDuration;
-
-    float prevJumpStrength;
-    float prevMinJumpHeight;
-    float prevMaxJumpHeight;
-    float prevJumpCooldownDuration;
-
-    float groundAcceleration;
-    float airAcceleration;
-    float maxWalkingSpeed;
-
-    float prevGroundAcceleration;
-    float prevAirAcceleration;
-    float prevMaxWalkingSpeed;
-
-    bool showDebugVisualizations;
-    bool showContactPoints;
-    bool showForceVisualizations;
-    int maxContactPoints;
+    SettingsRegistry settings;
+    // Contents of the settings file; keys the registry does not know are written back unchanged
 
-    bool enableBox2DDebugDraw;
-    bool drawShapes;
-    bool drawJoints;
-    bool drawAABBs;
-    bool drawContactPoints;
-    bool drawContactNormals;
-    bool drawContactImpulses;
-    bool drawFrictionImpulses;
+    const FrameStats* frameStats = nullptr;
+    const PhysicsStats* physicsStats = nullptr;
+    const StepGovernor* stepGovernor = nullptr;
+    FramePacer* framePacer = nullptr;
+    std::vector<float> histogramValues;
+    std::vector<float> physicsHistory;
 };
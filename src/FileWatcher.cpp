@@ -0,0 +1,167 @@
+#include "FileWatcher.h"
+#include "Logging.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+auto lastWriteTime(const std::string& path) -> fs::file_time_type {
+    std::error_code error;
+    fs::file_time_type time = fs::last_write_time(path, error);
+    return error ? fs::file_time_type::min() : time;
+}
+
+} // namespace
+
+FileWatcher::FileWatcher() {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0) {
+        getLogger(LogSubsystem::Assets)->warn("inotify unavailable ({}), polling for file changes", std::strerror(errno));
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+        }
+        if (wakeFd >= 0) {
+            close(wakeFd);
+        }
+        inotifyFd = -1;
+        wakeFd = -1;
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        close(wakeFd);
+    }
+#endif
+}
+
+auto FileWatcher::addFile(const std::string& path) -> bool {
+    if (std::any_of(files.begin(), files.end(), [&](const WatchedFile& file) { return file.path == path; })) {
+        return true;
+    }
+    fs::path filePath(path);
+    WatchedFile file;
+    file.path = path;
+    file.directory = filePath.has_parent_path() ? filePath.parent_path().string() : ".";
+    file.name = filePath.filename().string();
+    file.lastWrite = lastWriteTime(path);
+
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        // Watching the same directory again returns the existing descriptor
+        file.watchDescriptor = inotify_add_watch(inotifyFd, file.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (file.watchDescriptor < 0) {
+            getLogger(LogSubsystem::Assets)->warn("Cannot watch {}: {}", file.directory, std::strerror(errno));
+            return false;
+        }
+    }
+#endif
+    files.push_back(std::move(file));
+    return true;
+}
+
+auto FileWatcher::waitForChanges(std::chrono::milliseconds timeout) -> std::vector<std::string> {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        std::vector<uint8_t> changed(files.size(), 0);
+        bool anyChanged = false;
+        int waitMs = static_cast<int>(timeout.count());
+        while (true) {
+            std::array<pollfd, 2> fds = {{{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}}};
+            if (poll(fds.data(), fds.size(), waitMs) <= 0) {
+                break; // Timed out, or the burst has settled
+            }
+            // A wake ends the wait, but edits already read are still returned
+            const bool woken = (fds[1].revents & POLLIN) != 0;
+            if (woken) {
+                uint64_t count = 0;
+                [[maybe_unused]] ssize_t drained = read(wakeFd, &count, sizeof(count));
+            }
+
+            alignas(inotify_event) std::array<char, 4096> buffer{};
+            ssize_t length = 0;
+            while ((length = read(inotifyFd, buffer.data(), buffer.size())) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    for (size_t i = 0; i < files.size(); ++i) {
+                        // An overflowed queue may have lost events, so treat everything as changed
+                        const bool overflow = (event->mask & IN_Q_OVERFLOW) != 0;
+                        if (overflow || (event->wd == files[i].watchDescriptor && event->len > 0 && files[i].name == event->name)) {
+                            changed[i] = 1;
+                            anyChanged = true;
+                        }
+                    }
+                }
+            }
+            if (woken) {
+                break;
+            }
+            // Keep draining until the files have been quiet for a moment
+            waitMs = anyChanged ? static_cast<int>(SETTLE_TIME.count()) : waitMs;
+        }
+
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (changed[i] != 0) {
+                paths.push_back(files[i].path);
+            }
+        }
+        return paths;
+    }
+#endif
+
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, std::min(timeout, POLL_INTERVAL), [this] { return wakeRequested; });
+        if (wakeRequested) {
+            wakeRequested = false;
+            return {};
+        }
+    }
+    return pollModificationTimes();
+}
+
+void FileWatcher::wake() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wakeFd, &one, sizeof(one));
+        return;
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeRequested = true;
+    }
+    wakeCondition.notify_one();
+}
+
+auto FileWatcher::pollModificationTimes() -> std::vector<std::string> {
+    std::vector<std::string> paths;
+    for (WatchedFile& file : files) {
+        const fs::file_time_type time = lastWriteTime(file.path);
+        if (time != file.lastWrite) {
+            file.lastWrite = time;
+            paths.push_back(file.path);
+        }
+    }
+    return paths;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Reports changes to a fixed set of files. On Linux this is inotify on each
+// file's directory, so editors that save by writing a temp file and renaming
+// it over the original are still seen. Other platforms compare modification
+// times every poll interval. Meant to be driven by one background thread.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+
+    // Call from the thread that waits; adding a path twice is a no-op
+    auto addFile(const std::string& path) -> bool;
+
+    // Blocks until a watched file changes, timeout passes or wake() is called.
+    // Bursts of writes are coalesced; each changed path is reported once, as given to addFile.
+    auto waitForChanges(std::chrono::milliseconds timeout) -> std::vector<std::string>;
+    // Unblocks waitForChanges from another thread
+    void wake();
+
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{250};
+    static constexpr std::chrono::milliseconds SETTLE_TIME{50}; // Quiet period that ends a burst of writes
+
+private:
+    struct WatchedFile {
+        std::string path;
+        std::string directory;
+        std::string name;
+        int watchDescriptor = -1;
+        std::filesystem::file_time_type lastWrite;
+    };
+
+    std::vector<WatchedFile> files;
+    int inotifyFd = -1;
+    int wakeFd = -1;
+
+    // Polling fallback
+    auto pollModificationTimes() -> std::vector<std::string>;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool wakeRequested = false;
+};
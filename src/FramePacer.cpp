@@ -0,0 +1,130 @@
+#include "FramePacer.h"
+#include "Logging.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+struct PacingModeName {
+    PacingMode mode;
+    const char* name;
+};
+
+constexpr std::array<PacingModeName, FramePacer::MODE_COUNT> PACING_MODE_NAMES{{
+    {PacingMode::VSync, "vsync"},
+    {PacingMode::AdaptiveVSync, "adaptive"},
+    {PacingMode::Uncapped, "uncapped"},
+    {PacingMode::LateInput, "late-input"},
+}};
+
+auto nanosecondsToMilliseconds(uint64_t ns) -> float {
+    return static_cast<float>(static_cast<double>(ns) / static_cast<double>(FramePacer::NS_PER_MS));
+}
+
+auto millisecondsToNanoseconds(float ms) -> uint64_t {
+    return static_cast<uint64_t>(static_cast<double>(std::max(ms, 0.0f)) * static_cast<double>(FramePacer::NS_PER_MS));
+}
+
+} // namespace
+
+FramePacer::FramePacer(SDL_Renderer* renderer, float refreshRate, float frameLimit)
+    : renderer(renderer), refreshRate(refreshRate), frameLimit(frameLimit) {}
+
+auto FramePacer::setMode(PacingMode newMode) -> bool {
+    const int vsync = newMode == PacingMode::Uncapped ? SDL_RENDERER_VSYNC_DISABLED
+                    : newMode == PacingMode::AdaptiveVSync ? SDL_RENDERER_VSYNC_ADAPTIVE : 1;
+    if (!SDL_SetRenderVSync(renderer, vsync)) {
+        getLogger(LogSubsystem::Render)->warn("Pacing mode {} is not supported: {}", toString(newMode), SDL_GetError());
+        return false;
+    }
+    mode = newMode;
+    nextDeadlineNs = 0;
+    getLogger(LogSubsystem::Render)->info("Pacing mode {}", toString(mode));
+    return true;
+}
+
+void FramePacer::waitForInput() {
+    const uint64_t start = SDL_GetTicksNS();
+    if (mode == PacingMode::Uncapped && frameLimit > 0.0f) {
+        const uint64_t period = millisecondsToNanoseconds(1000.0f / frameLimit);
+        // After a long stall, start a new schedule instead of rushing frames to catch up
+        nextDeadlineNs = nextDeadlineNs + period < start ? start : nextDeadlineNs + period;
+        waitUntil(nextDeadlineNs);
+    } else if (mode == PacingMode::LateInput && lastPresentEndNs != 0 && refreshRate > 0.0f) {
+        const float slackMs = 1000.0f / refreshRate - workSummary.p95 - LATE_INPUT_SAFETY_MS;
+        waitUntil(lastPresentEndNs + millisecondsToNanoseconds(slackMs));
+    }
+    frameStartNs = SDL_GetTicksNS();
+    lastWaitMs = nanosecondsToMilliseconds(frameStartNs - start);
+}
+
+void FramePacer::noteInput(const SDL_Event& event) {
+    if (!isInputEvent(event) || event.common.timestamp == 0) {
+        return;
+    }
+    if (oldestInputNs == 0 || event.common.timestamp < oldestInputNs) {
+        oldestInputNs = event.common.timestamp;
+    }
+}
+
+void FramePacer::beginPresent() {
+    work.add(nanosecondsToMilliseconds(SDL_GetTicksNS() - frameStartNs));
+    workSummary = work.summarize();
+}
+
+void FramePacer::endPresent() {
+    lastPresentEndNs = SDL_GetTicksNS();
+    if (oldestInputNs != 0) {
+        latency.add(nanosecondsToMilliseconds(lastPresentEndNs - std::min(oldestInputNs, lastPresentEndNs)));
+        latencySummary = latency.summarize();
+        oldestInputNs = 0;
+    }
+}
+
+void FramePacer::waitUntil(uint64_t deadlineNs) {
+    uint64_t now = SDL_GetTicksNS();
+    if (deadlineNs > now + worstOversleepNs) {
+        const uint64_t wakeNs = deadlineNs - worstOversleepNs;
+        SDL_DelayNS(wakeNs - now);
+        now = SDL_GetTicksNS();
+        const uint64_t oversleep = now > wakeNs ? now - wakeNs : 0;
+        const auto decayed = static_cast<uint64_t>(static_cast<float>(worstOversleepNs) * OVERSLEEP_DECAY);
+        worstOversleepNs = std::max({decayed, oversleep, MIN_SPIN_NS});
+    }
+    while (now < deadlineNs) {
+        now = SDL_GetTicksNS();
+    }
+}
+
+auto FramePacer::toString(PacingMode mode) -> const char* {
+    for (const PacingModeName& entry : PACING_MODE_NAMES) {
+        if (entry.mode == mode) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+auto FramePacer::parse(std::string_view name, PacingMode& mode) -> bool {
+    for (const PacingModeName& entry : PACING_MODE_NAMES) {
+        if (name == entry.name) {
+            mode = entry.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+auto FramePacer::isInputEvent(const SDL_Event& event) -> bool {
+    switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "FrameStats.h"
+
+enum class PacingMode : uint8_t {
+    VSync,         // Present waits for vertical blank
+    AdaptiveVSync, // Like VSync, but a late frame tears instead of waiting a whole refresh
+    Uncapped,      // No vsync; the frame limiter paces frames
+    LateInput,     // VSync, with input sampled as late as the measured frame work allows
+};
+
+// Applies a PacingMode to the renderer and paces the main loop, and measures
+// input-to-present latency: the time from an input event's SDL timestamp to
+// the return of the SDL_RenderPresent that showed its first frame.
+//
+// Uncapped mode sleeps until shortly before the frame deadline and spins the
+// rest, since a plain sleep can overshoot by a millisecond or more. LateInput
+// keeps vsync but, after present returns, waits out the part of the refresh
+// the frame's own work does not need, so input is polled just before the
+// tick that uses it rather than a full refresh before presenting.
+class FramePacer {
+public:
+    static constexpr size_t MODE_COUNT = 4;
+    static constexpr uint64_t NS_PER_MS = 1'000'000;
+    static constexpr uint64_t MIN_SPIN_NS = 500'000;         // Sleep stops at least this long before a deadline
+    static constexpr float OVERSLEEP_DECAY = 0.99f;          // Per-sleep decay of the worst oversleep seen
+    static constexpr float LATE_INPUT_SAFETY_MS = 2.0f;      // Slack LateInput leaves on top of the p95 work time
+
+    // frameLimit is the Uncapped frame rate; 0 disables the limiter
+    FramePacer(SDL_Renderer* renderer, float refreshRate, float frameLimit);
+
+    // Returns false, and keeps the current mode, if the renderer rejects the vsync setting
+    auto setMode(PacingMode mode) -> bool;
+    void setFrameLimit(float framesPerSecond) { frameLimit = framesPerSecond; }
+
+    // Call at the top of the frame, before polling input
+    void waitForInput();
+    // Call for every input event polled this frame
+    void noteInput(const SDL_Event& event);
+    // Call around SDL_RenderPresent
+    void beginPresent();
+    void endPresent();
+
+    [[nodiscard]] auto getMode() const -> PacingMode { return mode; }
+    [[nodiscard]] auto getRefreshRate() const -> float { return refreshRate; }
+    [[nodiscard]] auto getFrameLimit() const -> float { return frameLimit; }
+    [[nodiscard]] auto getLastWaitMs() const -> float { return lastWaitMs; }
+    [[nodiscard]] auto getLatency() const -> const TimingHistogram& { return latency; }
+    [[nodiscard]] auto getLatencySummary() const -> const TimingSummary& { return latencySummary; }
+    [[nodiscard]] auto getWorkSummary() const -> const TimingSummary& { return workSummary; }
+
+    static auto toString(PacingMode mode) -> const char*;
+    // Accepts the names toString returns
+    static auto parse(std::string_view name, PacingMode& mode) -> bool;
+    static auto isInputEvent(const SDL_Event& event) -> bool;
+
+private:
+    // Sleeps most of the way to the deadline and spins the remainder
+    void waitUntil(uint64_t deadlineNs);
+
+    SDL_Renderer* renderer;
+    PacingMode mode = PacingMode::VSync;
+    float refreshRate;
+    float frameLimit;
+
+    uint64_t nextDeadlineNs = 0;
+    uint64_t frameStartNs = 0;
+    uint64_t lastPresentEndNs = 0;
+    uint64_t worstOversleepNs = MIN_SPIN_NS;
+    uint64_t oldestInputNs = 0; // 0 when no input is waiting to be presented
+    float lastWaitMs = 0.0f;
+
+    TimingHistogram work; // Input polling to present
+    TimingHistogram latency;
+    TimingSummary workSummary;
+    TimingSummary latencySummary;
+};
@@ -0,0 +1,166 @@
+#include "FrameStats.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace {
+
+constexpr size_t HITCH_ZONES_LOGGED = 3;
+
+auto elapsedMilliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) -> float {
+    return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+} // namespace
+
+void TimingHistogram::add(float ms) {
+    if (sampleCount == WINDOW_SIZE) {
+        buckets[bucketFor(samples[nextSample])]--;
+    } else {
+        sampleCount++;
+    }
+    samples[nextSample] = ms;
+    buckets[bucketFor(ms)]++;
+    nextSample = (nextSample + 1) % WINDOW_SIZE;
+}
+
+auto TimingHistogram::getSample(size_t age) const -> float {
+    return samples[(nextSample + WINDOW_SIZE - 1 - (age % WINDOW_SIZE)) % WINDOW_SIZE];
+}
+
+auto TimingHistogram::bucketFor(float ms) -> size_t {
+    if (!(ms > 0.0f)) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(ms / BUCKET_WIDTH_MS), BUCKET_COUNT - 1);
+}
+
+auto TimingHistogram::percentile(float fraction, float max) const -> float {
+    // Upper edge of the bucket holding the requested rank, never above the exact maximum
+    const auto rank = static_cast<uint32_t>(std::ceil(fraction * static_cast<float>(sampleCount)));
+    uint32_t cumulative = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT - 1; ++bucket) {
+        cumulative += buckets[bucket];
+        if (cumulative >= rank) {
+            return std::min(static_cast<float>(bucket + 1) * BUCKET_WIDTH_MS, max);
+        }
+    }
+    return max;
+}
+
+auto TimingHistogram::summarize() const -> TimingSummary {
+    TimingSummary summary;
+    if (sampleCount == 0) {
+        return summary;
+    }
+    float total = 0.0f;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        summary.max = std::max(summary.max, samples[i]);
+        total += samples[i];
+    }
+    summary.average = total / static_cast<float>(sampleCount);
+    summary.p50 = percentile(0.50f, summary.max);
+    summary.p95 = percentile(0.95f, summary.max);
+    summary.p99 = percentile(0.99f, summary.max);
+    return summary;
+}
+
+FrameStats::FrameStats(float frameBudgetMs)
+    : frameBudgetMs(frameBudgetMs) {}
+
+void FrameStats::beginSimTick() {
+    simTickStart = Clock::now();
+}
+
+void FrameStats::endSimTick() {
+    simMsThisFrame += elapsedMilliseconds(simTickStart, Clock::now());
+}
+
+void FrameStats::endFrame() {
+    Clock::time_point now = Clock::now();
+    const float frameMs = elapsedMilliseconds(lastFrameEnd, now);
+    lastFrameEnd = now;
+
+    frameTimes.add(frameMs);
+    simTimes.add(simMsThisFrame);
+
+    AllocationCounters totals = AllocationTracker::getTotals();
+    lastFrameAllocations = totals - allocationTotals;
+    allocationTotals = totals;
+    frameAllocations[frameIndex % TimingHistogram::WINDOW_SIZE] = lastFrameAllocations.allocations;
+    frameSummary = frameTimes.summarize();
+    simSummary = simTimes.summarize();
+
+    // The first frame includes startup and level loading
+    if (frameIndex > 0 && frameMs > HITCH_BUDGET_FACTOR * frameBudgetMs) {
+        recordHitch(frameMs, simMsThisFrame);
+    }
+
+    simMsThisFrame = 0.0f;
+    frameIndex++;
+}
+
+void FrameStats::recordHitch(float frameMs, float simMs) {
+    FrameHitch hitch{frameIndex, frameMs, simMs, {}};
+
+#ifdef PLATFORMER_PROFILER_ENABLED
+    std::vector<const ProfileZone*> topLevel;
+    for (const auto& zone : Profiler::getFrame(0).zones) {
+        if (zone.depth == 0) {
+            topLevel.push_back(&zone);
+        }
+    }
+    std::sort(topLevel.begin(), topLevel.end(), [](const ProfileZone* a, const ProfileZone* b) {
+        return (a->end - a->start) > (b->end - b->start);
+    });
+    for (size_t i = 0; i < std::min(topLevel.size(), HITCH_ZONES_LOGGED); ++i) {
+        if (!hitch.activity.empty()) {
+            hitch.activity += ", ";
+        }
+        hitch.activity += fmt::format("{} {:.2f} ms", topLevel[i]->name, Profiler::ticksToMilliseconds(topLevel[i]->end - topLevel[i]->start));
+    }
+#endif
+
+    spdlog::warn("Hitch in frame {}: {:.2f} ms (budget {:.2f} ms), simulation {:.2f} ms{}{}", hitch.frameIndex, frameMs, frameBudgetMs, simMs,
+                 hitch.activity.empty() ? "" : "; slowest zones: ", hitch.activity);
+
+    hitches.push_back(std::move(hitch));
+    if (hitches.size() > MAX_HITCHES) {
+        hitches.pop_front();
+    }
+    hitchCount++;
+}
+
+auto FrameStats::getPeakFrameAllocations() const -> uint64_t {
+    uint64_t peak = 0;
+    for (size_t age = 0; age < frameTimes.getSampleCount(); ++age) {
+        peak = std::max(peak, frameAllocations[(frameIndex - 1 - age) % TimingHistogram::WINDOW_SIZE]);
+    }
+    return peak;
+}
+
+auto FrameStats::writeCsv(const std::string& path) const -> bool {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        spdlog::error("Failed to open frame statistics file: {}", path);
+        return false;
+    }
+
+    out << "frame,frame_ms,sim_ms,hitch,allocations\n";
+    const size_t count = frameTimes.getSampleCount();
+    for (size_t age = count; age-- > 0;) {
+        const uint64_t frame = frameIndex - 1 - age;
+        const float frameMs = frameTimes.getSample(age);
+        out << frame << ',' << frameMs << ',' << simTimes.getSample(age) << ','
+            << (frameMs > HITCH_BUDGET_FACTOR * frameBudgetMs ? 1 : 0) << ','
+            << frameAllocations[frame % TimingHistogram::WINDOW_SIZE] << '\n';
+    }
+
+    spdlog::info("Frame times over the last {} frames: p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms, {} hitches",
+                 count, frameSummary.p50, frameSummary.p95, frameSummary.p99, frameSummary.max, hitchCount);
+    return true;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "AllocationTracker.h"
+
+struct TimingSummary {
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+    float average = 0.0f;
+};
+
+struct FrameHitch {
+    uint64_t frameIndex;
+    float frameMs;
+    float simMs;
+    std::string activity; // Slowest profiler zones of the frame, if the profiler is compiled in
+};
+
+// Rolling window of per-frame times with a fixed-bucket histogram, so
+// percentiles cost a bucket walk instead of a sort.
+class TimingHistogram {
+public:
+    static constexpr size_t WINDOW_SIZE = 600;
+    static constexpr float BUCKET_WIDTH_MS = 0.25f;
+    static constexpr size_t BUCKET_COUNT = 400; // 0-100 ms; the last bucket also holds anything slower
+
+    void add(float ms);
+    [[nodiscard]] auto summarize() const -> TimingSummary;
+
+    [[nodiscard]] auto getBuckets() const -> const std::array<uint32_t, BUCKET_COUNT>& { return buckets; }
+    [[nodiscard]] auto getSampleCount() const -> size_t { return sampleCount; }
+    // age 0 is the newest sample
+    [[nodiscard]] auto getSample(size_t age) const -> float;
+
+private:
+    static auto bucketFor(float ms) -> size_t;
+    auto percentile(float fraction, float max) const -> float;
+
+    std::array<float, WINDOW_SIZE> samples{};
+    std::array<uint32_t, BUCKET_COUNT> buckets{};
+    size_t sampleCount = 0;
+    size_t nextSample = 0;
+};
+
+// Frame and simulation tick timing for the last TimingHistogram::WINDOW_SIZE
+// frames. Frames slower than twice the budget are logged as hitches together
+// with what was running, and the window can be dumped as CSV.
+class FrameStats {
+public:
+    static constexpr size_t MAX_HITCHES = 32;
+    static constexpr float HITCH_BUDGET_FACTOR = 2.0f;
+
+    explicit FrameStats(float frameBudgetMs);
+
+    // Simulation work may be split over several begin/end pairs per frame
+    void beginSimTick();
+    void endSimTick();
+    // Call once per frame, after PROFILE_FRAME_MARK
+    void endFrame();
+
+    [[nodiscard]] auto getFrameBudgetMs() const -> float { return frameBudgetMs; }
+    [[nodiscard]] auto getFrameCount() const -> uint64_t { return frameIndex; }
+    [[nodiscard]] auto getFrameTimes() const -> const TimingHistogram& { return frameTimes; }
+    [[nodiscard]] auto getSimTimes() const -> const TimingHistogram& { return simTimes; }
+    [[nodiscard]] auto getFrameSummary() const -> const TimingSummary& { return frameSummary; }
+    [[nodiscard]] auto getSimSummary() const -> const TimingSummary& { return simSummary; }
+    [[nodiscard]] auto getHitches() const -> const std::deque<FrameHitch>& { return hitches; }
+    [[nodiscard]] auto getHitchCount() const -> uint64_t { return hitchCount; }
+
+    // Heap activity of the last completed frame; all zero unless AllocationTracker is enabled
+    [[nodiscard]] auto getLastFrameAllocations() const -> const AllocationCounters& { return lastFrameAllocations; }
+    [[nodiscard]] auto getPeakFrameAllocations() const -> uint64_t;
+
+    auto writeCsv(const std::string& path) const -> bool;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void recordHitch(float frameMs, float simMs);
+
+    float frameBudgetMs;
+    TimingHistogram frameTimes;
+    TimingHistogram simTimes;
+    TimingSummary frameSummary;
+    TimingSummary simSummary;
+
+    Clock::time_point lastFrameEnd = Clock::now();
+    Clock::time_point simTickStart;
+    float simMsThisFrame = 0.0f;
+    uint64_t frameIndex = 0;
+
+    std::deque<FrameHitch> hitches;
+    uint64_t hitchCount = 0;
+
+    AllocationCounters allocationTotals = AllocationTracker::getTotals();
+    AllocationCounters lastFrameAllocations;
+    std::array<uint64_t, TimingHistogram::WINDOW_SIZE> frameAllocations{}; // Indexed by frame % WINDOW_SIZE
+};
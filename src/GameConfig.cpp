@@ -0,0 +1,479 @@
+#include "GameConfig.h"
+#include "AssetFileSystem.h"
+#include "Logging.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+
+// Schema helpers. Fields are addressed by JSON pointer so errors point at the exact value.
+template <typename T>
+auto hasType(const nlohmann::json& value) -> bool {
+    if constexpr (std::is_same_v<T, bool>) {
+        return value.is_boolean();
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return value.is_number();
+    } else {
+        return value.is_string();
+    }
+}
+
+template <typename T>
+constexpr auto typeName() -> const char* {
+    if constexpr (std::is_same_v<T, bool>) {
+        return "boolean";
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return "number";
+    } else {
+        return "string";
+    }
+}
+
+template <typename T>
+auto readField(const nlohmann::json& root, const std::string& pointer, T& out, std::string& error) -> bool {
+    const nlohmann::json::json_pointer key(pointer);
+    if (!root.contains(key)) {
+        error = pointer + " is missing";
+        return false;
+    }
+    if (!hasType<T>(root.at(key))) {
+        error = fmt::format("{} must be a {}", pointer, typeName<T>());
+        return false;
+    }
+    out = root.at(key).get<T>();
+    return true;
+}
+
+// Missing fields keep the value already in out
+template <typename T>
+auto readOptionalField(const nlohmann::json& root, const std::string& pointer, T& out, std::string& error) -> bool {
+    return !root.contains(nlohmann::json::json_pointer(pointer)) || readField(root, pointer, out, error);
+}
+
+auto parseObject(const std::string& text, nlohmann::json& out, std::string& error) -> bool {
+    out = nlohmann::json::parse(text, nullptr, false);
+    if (out.is_discarded() || !out.is_object()) {
+        error = "not a JSON object";
+        return false;
+    }
+    return true;
+}
+
+auto parseAnimation(const nlohmann::json& root, const std::string& base, AnimationConfig& animation, std::string& error) -> bool {
+    if (!readField(root, base + "/name", animation.name, error) ||
+        !readField(root, base + "/filePath", animation.filePath, error) ||
+        !readField(root, base + "/animationSpeed", animation.animationSpeed, error) ||
+        !readField(root, base + "/frameSize/width", animation.frameWidth, error) ||
+        !readField(root, base + "/characterSpriteSize/width", animation.spriteWidth, error) ||
+        !readField(root, base + "/characterSpriteSize/height", animation.spriteHeight, error) ||
+        !readField(root, base + "/characterSpritePosition/x", animation.spriteX, error) ||
+        !readField(root, base + "/characterSpritePosition/y", animation.spriteY, error)) {
+        return false;
+    }
+    if (animation.animationSpeed <= 0.0F || animation.spriteWidth <= 0 || animation.spriteHeight <= 0) {
+        error = base + ": animationSpeed and characterSpriteSize must be positive";
+        return false;
+    }
+
+    const nlohmann::json::json_pointer framesKey(base + "/frames");
+    if (!root.contains(framesKey)) {
+        animation.looping = true;
+        return readField(root, base + "/frameCount", animation.frameCount, error) &&
+               readOptionalField(root, base + "/looping", animation.looping, error);
+    }
+    if (!root.at(framesKey).is_array()) {
+        error = base + "/frames must be an array";
+        return false;
+    }
+
+    animation.looping = false;
+    if (!readOptionalField(root, base + "/looping", animation.looping, error)) {
+        return false;
+    }
+    for (size_t i = 0; i < root.at(framesKey).size(); ++i) {
+        const std::string frameBase = fmt::format("{}/frames/{}", base, i);
+        FrameRange& range = animation.frames.emplace_back();
+        range.looping = animation.looping;
+        if (!readField(root, frameBase + "/type", range.type, error) ||
+            !readField(root, frameBase + "/startFrame", range.startFrame, error) ||
+            !readField(root, frameBase + "/frameCount", range.frameCount, error) ||
+            !readOptionalField(root, frameBase + "/looping", range.looping, error)) {
+            return false;
+        }
+        if (range.startFrame < 0 || range.frameCount < 0) {
+            error = frameBase + ": startFrame and frameCount must not be negative";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Binary cache. One field list per struct drives both directions, so they cannot drift apart.
+template <typename Archive, typename Config>
+void visitFields(Archive& archive, Config& config) {
+    using T = std::remove_const_t<Config>;
+    if constexpr (std::is_same_v<T, AppConfig>) {
+        archive(config.maxWalkingSpeed, config.preferredInputMethod, config.stepGovernor);
+    } else if constexpr (std::is_same_v<T, StepGovernorConfig>) {
+        archive(config.enabled, config.minSubSteps, config.maxSubSteps, config.stepBudgetMs);
+    } else if constexpr (std::is_same_v<T, FrameRange>) {
+        archive(config.type, config.startFrame, config.frameCount, config.looping);
+    } else if constexpr (std::is_same_v<T, AnimationConfig>) {
+        archive(config.name, config.filePath, config.animationSpeed, config.frameWidth, config.spriteWidth, config.spriteHeight,
+                config.spriteX, config.spriteY, config.frameCount, config.looping, config.frames);
+    } else if constexpr (std::is_same_v<T, CharacterConfig>) {
+        archive(config.width, config.height, config.initialX, config.initialY, config.groundAcceleration, config.airAcceleration,
+                config.maxWalkingSpeed, config.jumpStrength, config.controller, config.animations);
+    } else if constexpr (std::is_same_v<T, GameConfig>) {
+        archive(config.app, config.character, config.developerSettings);
+    } else {
+        static_assert(sizeof(T) == 0, "No field list for this type");
+    }
+}
+
+class CacheWriter {
+public:
+    template <typename... T>
+    void operator()(const T&... values) { (write(values), ...); }
+
+    std::vector<uint8_t> bytes;
+
+private:
+    template <typename T>
+    void write(const T& value) {
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            const auto* raw = reinterpret_cast<const uint8_t*>(&value);
+            bytes.insert(bytes.end(), raw, raw + sizeof(T));
+        } else {
+            visitFields(*this, value);
+        }
+    }
+    void write(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+    template <typename T>
+    void write(const std::vector<T>& values) {
+        write(static_cast<uint32_t>(values.size()));
+        for (const T& value : values) {
+            write(value);
+        }
+    }
+    void write(const SettingDelta& delta) {
+        write(static_cast<uint32_t>(delta.id));
+        write(static_cast<uint8_t>(delta.value.index()));
+        std::visit([this](auto value) { write(value); }, delta.value);
+    }
+};
+
+// Every read is bounds-checked; a short or inconsistent cache just fails
+class CacheReader {
+public:
+    CacheReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename... T>
+    void operator()(T&... values) { (read(values), ...); }
+
+    [[nodiscard]] auto succeeded() const -> bool { return !failed && offset == size; }
+
+private:
+    template <typename T>
+    void read(T& value) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (failed || size - offset < sizeof(T)) {
+                failed = true;
+                return;
+            }
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+        } else {
+            visitFields(*this, value);
+        }
+    }
+    void read(std::string& value) {
+        uint32_t length = 0;
+        read(length);
+        if (failed || size - offset < length) {
+            failed = true;
+            return;
+        }
+        value.assign(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+    }
+    template <typename T>
+    void read(std::vector<T>& values) {
+        uint32_t count = 0;
+        read(count);
+        if (failed || count > size - offset) { // Every element takes at least one byte
+            failed = true;
+            return;
+        }
+        values.resize(count);
+        for (T& value : values) {
+            read(value);
+        }
+    }
+    void read(CharacterController& controller) {
+        uint8_t value = 0;
+        read(value);
+        if (value > static_cast<uint8_t>(CharacterController::Kinematic)) {
+            failed = true;
+            return;
+        }
+        controller = static_cast<CharacterController>(value);
+    }
+    void read(SettingDelta& delta) {
+        uint32_t id = 0;
+        uint8_t index = 0;
+        read(id);
+        read(index);
+        if (failed || id >= SETTING_COUNT || index != SETTING_INFO[id].defaultValue.index()) {
+            failed = true;
+            return;
+        }
+        delta.id = static_cast<SettingId>(id);
+        delta.value = SETTING_INFO[id].defaultValue;
+        std::visit([this](auto& value) { read(value); }, delta.value);
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+};
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t payloadSize;
+    uint64_t payloadHash; // Catches corruption that still parses, e.g. a flipped byte in a float
+};
+
+constexpr char CACHE_MAGIC[4] = {'P', 'C', 'F', 'G'};
+
+// FNV-1a over every source, with lengths mixed in so content cannot shift between files
+auto hashSources(std::initializer_list<std::string_view> sources) -> uint64_t {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* bytes, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            hash ^= static_cast<const uint8_t*>(bytes)[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (std::string_view source : sources) {
+        const uint64_t length = source.size();
+        mix(&length, sizeof(length));
+        mix(source.data(), source.size());
+    }
+    return hash;
+}
+
+auto readCache(uint64_t sourceHash, GameConfig& config) -> bool {
+    std::ifstream file(ConfigLoader::CACHE_PATH, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::vector<uint8_t> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    CacheHeader header{};
+    if (contents.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != ConfigLoader::CACHE_VERSION ||
+        header.sourceHash != sourceHash || header.payloadSize != contents.size() - sizeof(header)) {
+        return false;
+    }
+    const std::string_view payload(reinterpret_cast<const char*>(contents.data() + sizeof(header)), header.payloadSize);
+    if (header.payloadHash != hashSources({payload})) {
+        getLogger(LogSubsystem::Game)->warn("{} is corrupt, parsing configs", ConfigLoader::CACHE_PATH);
+        return false;
+    }
+
+    GameConfig cached;
+    CacheReader reader(contents.data() + sizeof(header), contents.size() - sizeof(header));
+    visitFields(reader, cached);
+    if (!reader.succeeded()) {
+        return false;
+    }
+    config = std::move(cached);
+    return true;
+}
+
+// Written to a temporary file and renamed, so a crash never leaves a torn cache behind
+void writeCache(uint64_t sourceHash, const GameConfig& config) {
+    CacheWriter writer;
+    visitFields(writer, config);
+
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = ConfigLoader::CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.payloadSize = writer.bytes.size();
+    header.payloadHash = hashSources({std::string_view(reinterpret_cast<const char*>(writer.bytes.data()), writer.bytes.size())});
+
+    const std::string temporaryPath = std::string(ConfigLoader::CACHE_PATH) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(writer.bytes.data()), static_cast<std::streamsize>(writer.bytes.size()));
+        if (!file.good()) {
+            getLogger(LogSubsystem::Game)->warn("Failed to write {}", temporaryPath);
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, ConfigLoader::CACHE_PATH, error);
+    if (error) {
+        getLogger(LogSubsystem::Game)->warn("Failed to write {}: {}", ConfigLoader::CACHE_PATH, error.message());
+    }
+}
+
+} // namespace
+
+auto ConfigLoader::parseAppConfig(const std::string& text, AppConfig& out, std::string& error) -> bool {
+    nlohmann::json root;
+    AppConfig config;
+    if (!parseObject(text, root, error) ||
+        !readField(root, "/maxWalkingSpeed", config.maxWalkingSpeed, error) ||
+        !readField(root, "/preferredInputMethod", config.preferredInputMethod, error) ||
+        !readOptionalField(root, "/stepGovernor/enabled", config.stepGovernor.enabled, error) ||
+        !readOptionalField(root, "/stepGovernor/minSubSteps", config.stepGovernor.minSubSteps, error) ||
+        !readOptionalField(root, "/stepGovernor/maxSubSteps", config.stepGovernor.maxSubSteps, error) ||
+        !readOptionalField(root, "/stepGovernor/stepBudgetMs", config.stepGovernor.stepBudgetMs, error)) {
+        return false;
+    }
+    if (config.stepGovernor.minSubSteps < 1 || config.stepGovernor.maxSubSteps < config.stepGovernor.minSubSteps) {
+        error = "/stepGovernor needs 1 <= minSubSteps <= maxSubSteps";
+        return false;
+    }
+    if (config.stepGovernor.stepBudgetMs <= 0.0F) {
+        error = "/stepGovernor/stepBudgetMs must be positive";
+        return false;
+    }
+    out = std::move(config);
+    return true;
+}
+
+auto ConfigLoader::parseCharacterConfig(const std::string& text, CharacterConfig& out, std::string& error) -> bool {
+    nlohmann::json root;
+    CharacterConfig config;
+    if (!parseObject(text, root, error) ||
+        !readField(root, "/characterSize/width", config.width, error) ||
+        !readField(root, "/characterSize/height", config.height, error) ||
+        !readField(root, "/initialPosition/x", config.initialX, error) ||
+        !readField(root, "/initialPosition/y", config.initialY, error) ||
+        !readField(root, "/groundAcceleration", config.groundAcceleration, error) ||
+        !readField(root, "/airAcceleration", config.airAcceleration, error) ||
+        !readField(root, "/maxWalkingSpeed", config.maxWalkingSpeed, error) ||
+        !readField(root, "/jumpStrength", config.jumpStrength, error)) {
+        return false;
+    }
+    if (config.width <= 0 || config.height <= 0) {
+        error = "/characterSize must be positive";
+        return false;
+    }
+    std::string controller = "dynamic";
+    if (!readOptionalField(root, "/controller", controller, error)) {
+        return false;
+    }
+    if (controller != "dynamic" && controller != "kinematic") {
+        error = "/controller must be \"dynamic\" or \"kinematic\"";
+        return false;
+    }
+    config.controller = controller == "kinematic" ? CharacterController::Kinematic : CharacterController::Dynamic;
+    if (!root.contains("animations") || !root["animations"].is_array()) {
+        error = "/animations must be an array";
+        return false;
+    }
+    for (size_t i = 0; i < root["animations"].size(); ++i) {
+        if (!parseAnimation(root, fmt::format("/animations/{}", i), config.animations.emplace_back(), error)) {
+            return false;
+        }
+    }
+    out = std::move(config);
+    return true;
+}
+
+auto ConfigLoader::parseDeveloperSettings(const std::string& text, std::vector<SettingDelta>& out, std::string& error) -> bool {
+    nlohmann::json root;
+    if (!parseObject(text, root, error)) {
+        return false;
+    }
+    std::vector<SettingDelta> settings;
+    for (const SettingInfo& info : SETTING_INFO) {
+        SettingValue value = info.defaultValue;
+        const bool valid = std::visit([&](auto& typed) { return readOptionalField(root, std::string("/") + info.key, typed, error); }, value);
+        if (!valid) {
+            return false;
+        }
+        if (root.contains(info.key)) {
+            settings.push_back(SettingDelta{info.id, value});
+        }
+    }
+    out = std::move(settings);
+    return true;
+}
+
+auto ConfigLoader::load(GameConfig& config) -> bool {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    std::string appText;
+    std::string characterText;
+    std::string developerText;
+    if (!AssetFileSystem::readText(APP_CONFIG_PATH, appText)) {
+        getLogger(LogSubsystem::Game)->error("Failed to open {}", APP_CONFIG_PATH);
+        return false;
+    }
+    if (!AssetFileSystem::readText(CHARACTER_CONFIG_PATH, characterText)) {
+        getLogger(LogSubsystem::Game)->error("Failed to open {}", CHARACTER_CONFIG_PATH);
+        return false;
+    }
+    // Written by the developer menu, so always read from disk
+    const bool hasDeveloperSettings = AssetFileSystem::readLooseText(DEVELOPER_SETTINGS_PATH, developerText);
+
+    const uint64_t sourceHash = hashSources({appText, characterText, hasDeveloperSettings ? std::string_view(developerText) : std::string_view("\x01missing")});
+    if (readCache(sourceHash, config)) {
+        getLogger(LogSubsystem::Game)->info("Configs loaded from {} in {:.2f} ms", CACHE_PATH, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        return true;
+    }
+
+    GameConfig parsed;
+    std::string error;
+    if (!parseAppConfig(appText, parsed.app, error)) {
+        getLogger(LogSubsystem::Game)->error("Invalid {}: {}", APP_CONFIG_PATH, error);
+        return false;
+    }
+    if (!parseCharacterConfig(characterText, parsed.character, error)) {
+        getLogger(LogSubsystem::Game)->error("Invalid {}: {}", CHARACTER_CONFIG_PATH, error);
+        return false;
+    }
+
+    // The character's movement values seed the developer menu; saved menu values override them
+    parsed.developerSettings = {
+        {SettingId::GroundAcceleration, parsed.character.groundAcceleration},
+        {SettingId::AirAcceleration, parsed.character.airAcceleration},
+        {SettingId::MaxWalkingSpeed, parsed.character.maxWalkingSpeed},
+        {SettingId::JumpStrength, parsed.character.jumpStrength},
+    };
+    std::vector<SettingDelta> saved;
+    if (!hasDeveloperSettings) {
+        getLogger(LogSubsystem::Game)->warn("Failed to open {}. Using default settings.", DEVELOPER_SETTINGS_PATH);
+    } else if (!parseDeveloperSettings(developerText, saved, error)) {
+        getLogger(LogSubsystem::Game)->warn("Ignoring {}: {}", DEVELOPER_SETTINGS_PATH, error);
+    }
+    parsed.developerSettings.insert(parsed.developerSettings.end(), saved.begin(), saved.end());
+
+    writeCache(sourceHash, parsed);
+    config = std::move(parsed);
+    getLogger(LogSubsystem::Game)->info("Configs parsed in {:.2f} ms", std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Settings.h"
+
+// config.json
+// Quality bounds for StepGovernor, from config.json's optional "stepGovernor"
+struct StepGovernorConfig {
+    bool enabled = true;
+    int minSubSteps = 4;
+    int maxSubSteps = 8;
+    float stepBudgetMs = 4.0F; // Target cost of one b2World_Step
+
+    auto operator==(const StepGovernorConfig&) const -> bool = default;
+};
+
+struct AppConfig {
+    float maxWalkingSpeed = 0.0F;
+    std::string preferredInputMethod;
+    StepGovernorConfig stepGovernor;
+
+    auto operator==(const AppConfig&) const -> bool = default;
+};
+
+// A typed range of frames within a shared sprite sheet, e.g. the "jump" frames of the jumping sheet
+struct FrameRange {
+    std::string type;
+    int startFrame = 0;
+    int frameCount = 0;
+    bool looping = false;
+
+    auto operator==(const FrameRange&) const -> bool = default;
+};
+
+// One entry of character_config.json's "animations"
+struct AnimationConfig {
+    std::string name;
+    std::string filePath;
+    float animationSpeed = 0.0F; // Seconds per frame
+    int frameWidth = 0;          // Horizontal distance between frames in the sheet
+    int spriteWidth = 0;
+    int spriteHeight = 0;
+    int spriteX = 0;             // Centre of the first frame's sprite
+    int spriteY = 0;
+    int frameCount = 0;          // Whole-sheet animations only
+    bool looping = true;
+    std::vector<FrameRange> frames; // Empty for whole-sheet animations
+
+    auto operator==(const AnimationConfig&) const -> bool = default;
+};
+
+enum class CharacterController : uint8_t {
+    Dynamic,  // Box2D dynamic body, grounded from contacts
+    Kinematic // Swept box against the level's tile grid (KinematicController.h)
+};
+
+// character_config.json
+struct CharacterConfig {
+    int width = 0;
+    int height = 0;
+    float initialX = 0.0F;
+    float initialY = 0.0F;
+    float groundAcceleration = 0.0F;
+    float airAcceleration = 0.0F;
+    float maxWalkingSpeed = 0.0F;
+    float jumpStrength = 0.0F;
+    CharacterController controller = CharacterController::Dynamic; // "controller": "dynamic" or "kinematic"
+    std::vector<AnimationConfig> animations;
+
+    auto operator==(const CharacterConfig&) const -> bool = default;
+};
+
+// Everything read at startup
+struct GameConfig {
+    AppConfig app;
+    CharacterConfig character;
+    // Seeds from the character config followed by developer_menu_settings.json; apply in order
+    std::vector<SettingDelta> developerSettings;
+};
+
+// Reads the three startup JSON files into GameConfig. The result is also
+// written to a binary cache keyed by a hash of the source texts, so a start
+// with unchanged files skips JSON parsing. No JSON DOM outlives loading.
+class ConfigLoader {
+public:
+    static auto load(GameConfig& config) -> bool;
+
+    // Schema-checked parsers; on failure error names the offending field, e.g. "/animations/1/frameCount"
+    static auto parseAppConfig(const std::string& text, AppConfig& out, std::string& error) -> bool;
+    static auto parseCharacterConfig(const std::string& text, CharacterConfig& out, std::string& error) -> bool;
+    static auto parseDeveloperSettings(const std::string& text, std::vector<SettingDelta>& out, std::string& error) -> bool;
+
+    static constexpr const char* APP_CONFIG_PATH = "config.json";
+    static constexpr const char* CHARACTER_CONFIG_PATH = "character_config.json";
+    static constexpr const char* DEVELOPER_SETTINGS_PATH = "developer_menu_settings.json";
+    static constexpr const char* CACHE_PATH = "config.cache";
+    static constexpr uint32_t CACHE_VERSION = 3; // Bump whenever a struct above changes
+};
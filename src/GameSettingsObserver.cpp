@@ -4,44 +4,43 @@
 GameSettingsObserver::GameSettingsObserver(b2WorldId worldId, Character& character)
     : worldId(worldId), character(character) {}
 
-void GameSettingsObserver::onSettingChanged(const std::string& settingName, float newValue) {
-    if (settingName == "gravity") {
-        b2World_SetGravity(worldId, b2Vec2{0.0f, newValue});
-    } else if (settingName == "characterSpeed") {
-        character.setMaxWalkingSpeed(newValue);
-    } else if (settingName == "jumpStrength") {
-        character.setJumpStrength(newValue);
-    } else if (settingName == "jumpCooldownDuration") {
-        character.setJumpCooldownDuration(newValue);
-    } else if (settingName == "groundAcceleration") {
-        character.setGroundAcceleration(newValue);
-    } else if (settingName == "airAcceleration") {
-        character.setAirAcceleration(newValue);
-    } else if (settingName == "maxWalkingSpeed") {
-        character.setMaxWalkingSpeed(newValue);
-    } else if (settingName == "showDebugVisualizations") {
-        character.setShowDebugRectangles(static_cast<bool>(newValue));
-    } else if (settingName == "showContactPoints") {
-        character.setShowContactPoints(static_cast<bool>(newValue));
-    } else if (settingName == "showForceVisualizations") {
-        character.setShowForceVectors(static_cast<bool>(newValue));
-    } else if (settingName == "maxContactPoints") {
-        character.setMaxContactPoints(static_cast<int>(newValue));
-    } else if (settingName == "enableBox2DDebugDraw") {
-        // Handle enabling/disabling Box2D debug draw
-    } else if (settingName == "drawShapes") {
-        // Handle drawing shapes
-    } else if (settingName == "drawJoints") {
-        // Handle drawing joints
-    } else if (settingName == "drawAABBs") {
-        // Handle drawing AABBs
-    } else if (settingName == "drawContactPoints") {
-        // Handle drawing contact points
-    } else if (settingName == "drawContactNormals") {
-        // Handle drawing contact normals
-    } else if (settingName == "drawContactImpulses") {
-        // Handle drawing contact impulses
-    } else if (settingName == "drawFrictionImpulses") {
-        // Handle drawing friction impulses
+void GameSettingsObserver::onSettingsChanged(std::span<const SettingDelta> changes) {
+    for (const SettingDelta& change : changes) {
+        switch (change.id) {
+            case SettingId::Gravity:
+                b2World_SetGravity(worldId, b2Vec2{0.0f, change.get<float>()});
+                break;
+            case SettingId::CharacterSpeed:
+            case SettingId::MaxWalkingSpeed:
+                character.setMaxWalkingSpeed(change.get<float>());
+                break;
+            case SettingId::JumpStrength:
+                character.setJumpStrength(change.get<float>());
+                break;
+            case SettingId::JumpCooldownDuration:
+                character.setJumpCooldownDuration(change.get<float>());
+                break;
+            case SettingId::GroundAcceleration:
+                character.setGroundAcceleration(change.get<float>());
+                break;
+            case SettingId::AirAcceleration:
+                character.setAirAcceleration(change.get<float>());
+                break;
+            case SettingId::ShowDebugVisualizations:
+                character.setShowDebugRectangles(change.get<bool>());
+                break;
+            case SettingId::ShowContactPoints:
+                character.setShowContactPoints(change.get<bool>());
+                break;
+            case SettingId::ShowForceVisualizations:
+                character.setShowForceVectors(change.get<bool>());
+                break;
+            case SettingId::MaxContactPoints:
+                character.setMaxContactPoints(change.get<int>());
+                break;
+            default:
+                // Jump heights are not used by the character yet; Box2D debug draw flags are read by the main loop
+                break;
+        }
     }
 }
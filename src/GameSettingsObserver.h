@@ -6,16 +6,9 @@
 class GameSettingsObserver : public Observer {
 public:
     GameSettingsObserver(b2WorldId worldId, Character& character);
-    virtual void onSettingChanged(const std::string& settingName, float newValue) override;
+    void onSettingsChanged(std::span<const SettingDelta> changes) override;
 
 private:
     b2WorldId worldId;
     Character& character;
-
-    float jumpStrength;
-    float minJumpHeight;
-    float maxJumpHeight;
-    float jumpCooldownDuration;
-
-    void handleDebugVisualizationSetting(const std::string& settingName, float newValue);
 };
@@ -0,0 +1,218 @@
+#include "InputBuffer.h"
+#include "Logging.h"
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+constexpr uint64_t MAX_REPLAY_TICKS = uint64_t{1} << 24; // Over three days at 60 Hz
+
+// Parses the next comma-separated unsigned field of line, advancing past it
+template <typename T>
+auto parseField(std::string_view& line, T& value) -> bool {
+    const auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), value);
+    if (error != std::errc{}) {
+        return false;
+    }
+    line.remove_prefix(static_cast<size_t>(end - line.data()));
+    if (!line.empty() && line.front() == ',') {
+        line.remove_prefix(1);
+    }
+    return true;
+}
+
+} // namespace
+
+InputBuffer::InputBuffer() {
+    pending.reserve(64);
+}
+
+InputBuffer::~InputBuffer() {
+    for (SDL_Gamepad* gamepad : gamepads) {
+        SDL_CloseGamepad(gamepad);
+    }
+}
+
+void InputBuffer::handleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP: {
+            if (event.key.repeat) {
+                return;
+            }
+            const bool down = event.type == SDL_EVENT_KEY_DOWN;
+            switch (event.key.key) {
+                case SDLK_LEFT:
+                case SDLK_A:
+                    queue(event.key.timestamp, Source::Keyboard, 0, InputButton::Left, down);
+                    break;
+                case SDLK_RIGHT:
+                case SDLK_D:
+                    queue(event.key.timestamp, Source::Keyboard, 0, InputButton::Right, down);
+                    break;
+                case SDLK_UP:
+                case SDLK_W:
+                    queue(event.key.timestamp, Source::Keyboard, 0, InputButton::Jump, down);
+                    break;
+                case SDLK_DOWN:
+                case SDLK_S:
+                    queue(event.key.timestamp, Source::Keyboard, 0, InputButton::Down, down);
+                    break;
+            }
+            break;
+        }
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP: {
+            const bool down = event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN;
+            switch (event.gbutton.button) {
+                case SDL_GAMEPAD_BUTTON_DPAD_LEFT:
+                    queue(event.gbutton.timestamp, Source::GamepadButtons, event.gbutton.which, InputButton::Left, down);
+                    break;
+                case SDL_GAMEPAD_BUTTON_DPAD_RIGHT:
+                    queue(event.gbutton.timestamp, Source::GamepadButtons, event.gbutton.which, InputButton::Right, down);
+                    break;
+                case SDL_GAMEPAD_BUTTON_SOUTH:
+                case SDL_GAMEPAD_BUTTON_DPAD_UP:
+                    queue(event.gbutton.timestamp, Source::GamepadButtons, event.gbutton.which, InputButton::Jump, down);
+                    break;
+                case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+                    queue(event.gbutton.timestamp, Source::GamepadButtons, event.gbutton.which, InputButton::Down, down);
+                    break;
+            }
+            break;
+        }
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            queueStick(event.gaxis.timestamp, event.gaxis.which, event.gaxis.axis, event.gaxis.value);
+            break;
+        case SDL_EVENT_GAMEPAD_ADDED:
+            if (SDL_Gamepad* gamepad = SDL_OpenGamepad(event.gdevice.which)) {
+                gamepads.push_back(gamepad);
+                getLogger(LogSubsystem::Game)->info("Gamepad {} connected", event.gdevice.which);
+            } else {
+                getLogger(LogSubsystem::Game)->warn("Failed to open gamepad {}: {}", event.gdevice.which, SDL_GetError());
+            }
+            break;
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            if (SDL_Gamepad* gamepad = SDL_GetGamepadFromID(event.gdevice.which)) {
+                std::erase(gamepads, gamepad);
+                SDL_CloseGamepad(gamepad);
+                queueRelease(event.gdevice.timestamp, event.gdevice.which);
+                getLogger(LogSubsystem::Game)->info("Gamepad {} disconnected", event.gdevice.which);
+            }
+            break;
+    }
+}
+
+void InputBuffer::queue(uint64_t timestampNs, Source source, SDL_JoystickID device, InputButton button, bool down) {
+    pending.push_back(Event{timestampNs, source, device, button, down});
+}
+
+void InputBuffer::queueStick(uint64_t timestampNs, SDL_JoystickID device, uint8_t axis, int16_t value) {
+    if (axis == SDL_GAMEPAD_AXIS_LEFTX) {
+        queue(timestampNs, Source::GamepadStick, device, InputButton::Left, value < -STICK_DEAD_ZONE);
+        queue(timestampNs, Source::GamepadStick, device, InputButton::Right, value > STICK_DEAD_ZONE);
+    } else if (axis == SDL_GAMEPAD_AXIS_LEFTY) {
+        // Positive is down
+        queue(timestampNs, Source::GamepadStick, device, InputButton::Down, value > STICK_DEAD_ZONE);
+    }
+}
+
+void InputBuffer::queueRelease(uint64_t timestampNs, SDL_JoystickID device) {
+    for (InputButton button : {InputButton::Left, InputButton::Right, InputButton::Jump, InputButton::Down}) {
+        queue(timestampNs, Source::GamepadButtons, device, button, false);
+        queue(timestampNs, Source::GamepadStick, device, button, false);
+    }
+}
+
+auto InputBuffer::heldButtons(Source source, SDL_JoystickID device) -> uint8_t& {
+    for (HeldButtons& entry : held) {
+        if (entry.source == source && entry.device == device) {
+            return entry.buttons;
+        }
+    }
+    held.push_back(HeldButtons{source, device, 0});
+    return held.back().buttons;
+}
+
+auto InputBuffer::sampleTick(uint64_t tick, uint64_t untilNs) -> TickInput {
+    // Devices queue separately, so events from several can arrive out of order
+    std::stable_sort(pending.begin(), pending.end(), [](const Event& a, const Event& b) { return a.timestampNs < b.timestampNs; });
+
+    auto combined = [this] {
+        uint8_t buttons = 0;
+        for (const HeldButtons& entry : held) {
+            buttons |= entry.buttons;
+        }
+        return buttons;
+    };
+
+    TickInput input;
+    auto event = pending.begin();
+    for (; event != pending.end() && event->timestampNs <= untilNs; ++event) {
+        const uint8_t bit = TickInput::bit(event->button);
+        if (event->down) {
+            if ((combined() & bit) == 0) {
+                input.pressed |= bit;
+            }
+            heldButtons(event->source, event->device) |= bit;
+        } else {
+            heldButtons(event->source, event->device) &= static_cast<uint8_t>(~bit);
+        }
+    }
+    pending.erase(pending.begin(), event);
+    std::erase_if(held, [](const HeldButtons& entry) { return entry.buttons == 0; });
+    input.held = combined();
+
+    if (isReplaying(tick)) {
+        input = replay[tick];
+    }
+    if (recording.is_open()) {
+        recording << tick << ',' << static_cast<unsigned>(input.held) << ',' << static_cast<unsigned>(input.pressed) << '\n';
+    }
+    return input;
+}
+
+auto InputBuffer::startRecording(const std::string& path) -> bool {
+    recording.open(path);
+    if (!recording.is_open()) {
+        getLogger(LogSubsystem::Game)->error("Failed to open input recording: {}", path);
+        return false;
+    }
+    recording << "tick,held,pressed\n";
+    return true;
+}
+
+auto InputBuffer::loadReplay(const std::string& path) -> bool {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        getLogger(LogSubsystem::Game)->error("Failed to open input replay: {}", path);
+        return false;
+    }
+
+    std::vector<TickInput> ticks;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (lineNumber == 1 || line.empty()) {
+            continue; // Header
+        }
+        std::string_view fields(line);
+        uint64_t tick = 0;
+        TickInput input;
+        if (!parseField(fields, tick) || !parseField(fields, input.held) || !parseField(fields, input.pressed) || tick >= MAX_REPLAY_TICKS) {
+            getLogger(LogSubsystem::Game)->error("{}:{}: expected tick,held,pressed", path, lineNumber);
+            return false;
+        }
+        if (tick >= ticks.size()) {
+            ticks.resize(tick + 1);
+        }
+        ticks[tick] = input;
+    }
+
+    replay = std::move(ticks);
+    getLogger(LogSubsystem::Game)->info("Replaying {} ticks of input from {}", replay.size(), path);
+    return true;
+}
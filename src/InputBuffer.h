@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+enum class InputButton : uint8_t {
+    Left,
+    Right,
+    Jump,
+    Down,
+};
+
+// What one player did during one simulation tick. Two bytes, so recordings
+// and snapshots stay small.
+struct TickInput {
+    uint8_t held = 0;    // Buttons down at the end of the tick
+    uint8_t pressed = 0; // Buttons pressed during the tick, even if released again before it ended
+
+    static constexpr auto bit(InputButton button) -> uint8_t { return static_cast<uint8_t>(1U << static_cast<unsigned>(button)); }
+    [[nodiscard]] auto isHeld(InputButton button) const -> bool { return (held & bit(button)) != 0; }
+    [[nodiscard]] auto wasPressed(InputButton button) const -> bool { return (pressed & bit(button)) != 0; }
+    auto operator==(const TickInput&) const -> bool = default;
+};
+
+// Turns keyboard and gamepad events into one TickInput per simulation tick.
+// Events are queued with their SDL timestamps and only applied when a tick
+// samples them, in timestamp order, so a press and release within one frame
+// still reaches the simulation and the result does not depend on when in the
+// frame events were polled. Sampled ticks can be recorded to a CSV file, and
+// a recording replayed in place of live input.
+class InputBuffer {
+public:
+    static constexpr int16_t STICK_DEAD_ZONE = 8000; // Of +-32767
+
+    InputBuffer();
+    ~InputBuffer();
+    InputBuffer(const InputBuffer&) = delete;
+    auto operator=(const InputBuffer&) -> InputBuffer& = delete;
+
+    // Queues the button changes in an event; also opens and closes gamepads as they connect
+    void handleEvent(const SDL_Event& event);
+    // Applies the queued events stamped up to untilNs (SDL_GetTicksNS time) and
+    // returns the input for tick; call once per simulated tick
+    auto sampleTick(uint64_t tick, uint64_t untilNs) -> TickInput;
+
+    // Writes every sampled tick as "tick,held,pressed"
+    auto startRecording(const std::string& path) -> bool;
+    // Ticks the file covers use its input instead of the live input; a tick recorded twice, e.g. after a rewind, uses the last line
+    auto loadReplay(const std::string& path) -> bool;
+    [[nodiscard]] auto isReplaying(uint64_t tick) const -> bool { return tick < replay.size(); }
+
+private:
+    // Each source of each device keeps its own held buttons, so releasing a key or a
+    // gamepad button does not release the same button held on another device
+    enum class Source : uint8_t {
+        Keyboard,
+        GamepadButtons,
+        GamepadStick,
+    };
+
+    struct Event {
+        uint64_t timestampNs;
+        Source source;
+        SDL_JoystickID device; // 0 for the keyboard
+        InputButton button;
+        bool down;
+    };
+
+    struct HeldButtons {
+        Source source;
+        SDL_JoystickID device;
+        uint8_t buttons;
+    };
+
+    void queue(uint64_t timestampNs, Source source, SDL_JoystickID device, InputButton button, bool down);
+    void queueStick(uint64_t timestampNs, SDL_JoystickID device, uint8_t axis, int16_t value);
+    // Queues releases of everything a disconnected gamepad could be holding
+    void queueRelease(uint64_t timestampNs, SDL_JoystickID device);
+    auto heldButtons(Source source, SDL_JoystickID device) -> uint8_t&;
+
+    std::vector<Event> pending;
+    std::vector<HeldButtons> held; // Only sources with a button down
+    std::vector<SDL_Gamepad*> gamepads;
+    std::ofstream recording;
+    std::vector<TickInput> replay; // Indexed by tick
+};
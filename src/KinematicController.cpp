@@ -0,0 +1,212 @@
+#include "KinematicController.h"
+#include "Level.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+constexpr float EPSILON = 1e-4f;
+
+auto cellOf(float coordinate) -> int {
+    return static_cast<int>(std::floor(coordinate));
+}
+
+// Height of a tile's top above the bottom of its cell, at localX in [0, 1]
+auto surfaceHeight(TileCollision tile, float localX) -> float {
+    switch (tile) {
+        case TileCollision::SlopeUp:
+            return std::clamp(localX, 0.0f, 1.0f);
+        case TileCollision::SlopeDown:
+            return 1.0f - std::clamp(localX, 0.0f, 1.0f);
+        default:
+            return 1.0f;
+    }
+}
+
+// Whether the side of column facing the mover, at localX, overlaps the box.
+// Faces no higher than tolerance above the box's bottom can be stepped onto.
+auto blocksEntry(const TileCollisionGrid& grid, int column, float localX, float bottom, float top, float tolerance) -> bool {
+    for (int row = cellOf(bottom + EPSILON); row <= cellOf(top - EPSILON); ++row) {
+        const TileCollision tile = grid.at(column, row);
+        if (tile == TileCollision::Empty || tile == TileCollision::OneWay) {
+            continue;
+        }
+        const auto faceBottom = static_cast<float>(row);
+        const float faceTop = faceBottom + surfaceHeight(tile, localX);
+        if (faceTop > bottom + tolerance && faceBottom < top - EPSILON) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+auto TileCollisionGrid::classify(int tileId) -> TileCollision {
+    switch (tileId) {
+        case 1:
+        case 2:
+            return TileCollision::Solid;
+        case 3:
+            return TileCollision::OneWay;
+        case 4:
+            return TileCollision::SlopeUp;
+        case 5:
+            return TileCollision::SlopeDown;
+        default:
+            return TileCollision::Empty;
+    }
+}
+
+void TileCollisionGrid::build(const TilemapData& map) {
+    // Cells are one metre, like the chain outlines and tile sprites
+    assert(static_cast<float>(map.tileWidth) == PIXELS_PER_METER && static_cast<float>(map.tileHeight) == PIXELS_PER_METER);
+    width = map.width;
+    height = map.height;
+    cells.assign(map.tiles.size(), TileCollision::Empty);
+    // Tiled rows run top to bottom
+    for (int row = 0; row < height; ++row) {
+        for (int x = 0; x < width; ++x) {
+            cells[(static_cast<size_t>(height - row - 1) * width) + x] = classify(map.tiles[(static_cast<size_t>(row) * width) + x]);
+        }
+    }
+}
+
+void KinematicController::step(const TileCollisionGrid& grid, const KinematicParams& params, const KinematicInput& input, float deltaTime, KinematicState& state) {
+    const float acceleration = state.grounded ? params.groundAcceleration : params.airAcceleration;
+    if (input.move != 0.0f) {
+        state.velocity.x = std::clamp(state.velocity.x + (input.move * acceleration * deltaTime), -params.maxWalkingSpeed, params.maxWalkingSpeed);
+    } else if (state.grounded) {
+        // Stands in for the dynamic body's friction
+        const float slowdown = params.groundAcceleration * deltaTime;
+        state.velocity.x = std::abs(state.velocity.x) <= slowdown ? 0.0f : state.velocity.x - std::copysign(slowdown, state.velocity.x);
+    }
+
+    if (input.jump && state.grounded) {
+        state.velocity.y = params.jumpVelocity;
+        state.grounded = false;
+    }
+    state.velocity.y += params.gravity * deltaTime;
+
+    const float dx = state.velocity.x * deltaTime;
+    const float dy = state.velocity.y * deltaTime;
+    const int steps = std::max(1, static_cast<int>(std::ceil(std::max(std::abs(dx), std::abs(dy)) / MAX_STEP_DISTANCE)));
+    for (int i = 0; i < steps; ++i) {
+        moveX(grid, params, dx / static_cast<float>(steps), input.dropThrough, state);
+        moveY(grid, params, dy / static_cast<float>(steps), input.dropThrough, state);
+    }
+}
+
+void KinematicController::moveX(const TileCollisionGrid& grid, const KinematicParams& params, float dx, bool dropThrough, KinematicState& state) {
+    if (dx == 0.0f) {
+        return;
+    }
+    const float bottom = state.position.y - params.halfHeight;
+    const float top = state.position.y + params.halfHeight;
+    // On the ground the box may climb as far as it moves, which is exactly a 45 degree slope
+    const float tolerance = state.grounded ? std::abs(dx) + EPSILON : EPSILON;
+
+    float x = state.position.x + dx;
+    if (dx > 0.0f) {
+        const float edge = state.position.x + params.halfWidth;
+        for (int column = cellOf(edge - EPSILON) + 1; column <= cellOf(edge + dx - EPSILON); ++column) {
+            if (blocksEntry(grid, column, 0.0f, bottom, top, tolerance)) {
+                x = static_cast<float>(column) - params.halfWidth;
+                state.velocity.x = 0.0f;
+                break;
+            }
+        }
+    } else {
+        const float edge = state.position.x - params.halfWidth;
+        for (int column = cellOf(edge + EPSILON) - 1; column >= cellOf(edge + dx + EPSILON); --column) {
+            if (blocksEntry(grid, column, 1.0f, bottom, top, tolerance)) {
+                x = static_cast<float>(column + 1) + params.halfWidth;
+                state.velocity.x = 0.0f;
+                break;
+            }
+        }
+    }
+    state.position.x = x;
+
+    // Follow slopes and steps in both directions instead of launching off them
+    float ground = 0.0f;
+    const float reach = std::abs(dx) + EPSILON;
+    if (state.grounded && findGround(grid, x - params.halfWidth, x + params.halfWidth, bottom + reach, bottom - reach, bottom, dropThrough, ground)) {
+        state.position.y = ground + params.halfHeight;
+    }
+}
+
+void KinematicController::moveY(const TileCollisionGrid& grid, const KinematicParams& params, float dy, bool dropThrough, KinematicState& state) {
+    const float left = state.position.x - params.halfWidth;
+    const float right = state.position.x + params.halfWidth;
+    if (dy < 0.0f) {
+        const float bottom = state.position.y - params.halfHeight;
+        float ground = 0.0f;
+        if (findGround(grid, left, right, bottom + EPSILON, bottom + dy, bottom, dropThrough, ground)) {
+            state.position.y = ground + params.halfHeight;
+            state.velocity.y = 0.0f;
+            state.grounded = true;
+        } else {
+            state.position.y += dy;
+            state.grounded = false;
+        }
+        return;
+    }
+    if (dy > 0.0f) {
+        const float top = state.position.y + params.halfHeight;
+        // Slopes have flat undersides, so anything but a one-way platform is a ceiling
+        for (int row = cellOf(top - EPSILON) + 1; row <= cellOf(top + dy - EPSILON); ++row) {
+            for (int column = cellOf(left + EPSILON); column <= cellOf(right - EPSILON); ++column) {
+                const TileCollision tile = grid.at(column, row);
+                if (tile != TileCollision::Empty && tile != TileCollision::OneWay) {
+                    state.position.y = static_cast<float>(row) - params.halfHeight;
+                    state.velocity.y = 0.0f;
+                    state.grounded = false;
+                    return;
+                }
+            }
+        }
+        state.position.y += dy;
+        state.grounded = false;
+    }
+}
+
+auto KinematicController::findGround(const TileCollisionGrid& grid, float left, float right, float highest, float lowest, float previousBottom, bool dropThrough, float& ground) -> bool {
+    bool found = false;
+    for (int column = cellOf(left + EPSILON); column <= cellOf(right - EPSILON); ++column) {
+        // A surface at the very top of a cell belongs to the row below, hence the extra row
+        for (int row = cellOf(highest); row >= cellOf(lowest) - 1; --row) {
+            const TileCollision tile = grid.at(column, row);
+            const auto cellBottom = static_cast<float>(row);
+            float surface = 0.0f;
+            switch (tile) {
+                case TileCollision::Empty:
+                    continue;
+                case TileCollision::OneWay:
+                    // Only catches a box that was above it before this move
+                    if (dropThrough || previousBottom < cellBottom + 1.0f - EPSILON) {
+                        continue;
+                    }
+                    surface = cellBottom + 1.0f;
+                    break;
+                case TileCollision::SlopeUp:
+                    // The box rests on the slope by its corner on the high side
+                    surface = cellBottom + surfaceHeight(tile, std::min(right, static_cast<float>(column + 1)) - static_cast<float>(column));
+                    break;
+                case TileCollision::SlopeDown:
+                    surface = cellBottom + surfaceHeight(tile, std::max(left, static_cast<float>(column)) - static_cast<float>(column));
+                    break;
+                default:
+                    surface = cellBottom + 1.0f;
+                    break;
+            }
+            if (surface >= lowest && surface <= highest && (!found || surface > ground)) {
+                ground = surface;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
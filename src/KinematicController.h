@@ -0,0 +1,81 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct TilemapData;
+
+// How a tile collides with kinematic characters
+enum class TileCollision : uint8_t {
+    Empty,
+    Solid,
+    OneWay,    // Only the top blocks, and only when landed on from above
+    SlopeUp,   // 45 degrees, rising to the right
+    SlopeDown, // 45 degrees, rising to the left
+};
+
+// Collision shapes of the tilemap in world space: one cell per tile, one metre
+// per cell (the same units as the level's chain outlines), row 0 at the bottom.
+// Maps must therefore use tiles of PIXELS_PER_METER pixels.
+class TileCollisionGrid {
+public:
+    void build(const TilemapData& map);
+
+    // Outside the map is empty
+    [[nodiscard]] auto at(int x, int y) const -> TileCollision {
+        return x >= 0 && x < width && y >= 0 && y < height ? cells[(static_cast<size_t>(y) * width) + x] : TileCollision::Empty;
+    }
+    [[nodiscard]] auto getWidth() const -> int { return width; }
+    [[nodiscard]] auto getHeight() const -> int { return height; }
+
+    // Tile ids 1 and 2 are the level's solid tiles; 3-5 have no Box2D geometry
+    // and are only seen by kinematic characters
+    static auto classify(int tileId) -> TileCollision;
+
+private:
+    int width = 0;
+    int height = 0;
+    std::vector<TileCollision> cells;
+};
+
+struct KinematicParams {
+    float halfWidth = 0.5f;
+    float halfHeight = 0.5f;
+    float gravity = -9.8f;          // m/s^2, usually the world's
+    float groundAcceleration = 0.0f;
+    float airAcceleration = 0.0f;
+    float maxWalkingSpeed = 0.0f;
+    float jumpVelocity = 0.0f;      // Vertical speed at take-off
+};
+
+struct KinematicInput {
+    float move = 0.0f;        // -1 left .. 1 right
+    bool jump = false;        // Only acted on while grounded
+    bool dropThrough = false; // Fall through a one-way platform being stood on
+};
+
+struct KinematicState {
+    b2Vec2 position{};        // Centre of the box
+    b2Vec2 velocity{};
+    bool grounded = false;
+};
+
+// Platformer movement without a rigid-body solve: the character is an
+// axis-aligned box swept through the tile grid, X then Y, in sub-steps of at
+// most MAX_STEP_DISTANCE so no speed can tunnel through a tile. Boxes rest on
+// slopes by the corner nearest the high side and walk up and down them
+// without leaving the ground.
+class KinematicController {
+public:
+    static void step(const TileCollisionGrid& grid, const KinematicParams& params, const KinematicInput& input, float deltaTime, KinematicState& state);
+
+    static constexpr float MAX_STEP_DISTANCE = 0.25f;
+
+private:
+    static void moveX(const TileCollisionGrid& grid, const KinematicParams& params, float dx, bool dropThrough, KinematicState& state);
+    static void moveY(const TileCollisionGrid& grid, const KinematicParams& params, float dy, bool dropThrough, KinematicState& state);
+    // Highest surface under [left, right] whose height lies in [lowest, highest]
+    static auto findGround(const TileCollisionGrid& grid, float left, float right, float highest, float lowest, float previousBottom, bool dropThrough, float& ground) -> bool;
+};
@@ -3,12 +3,19 @@
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <iostream>
-#include <fstream>
-#include <set>
 #include <nlohmann/json.hpp>
-#include <spdlog/spdlog.h>
-#include <queue>
+#include "Logging.h"
 #include "Box2DDebugDraw.h"
+#include "AssetCache.h"
+#include "AssetFileSystem.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <utility>
+
+// Initial size of the level-load arena: tile grids, the BFS list and traced outlines fit comfortably
+constexpr size_t LOAD_ARENA_BYTES_PER_TILE = 64;
 
 Level::Level(SDL_Renderer* renderer, b2WorldId worldId, std::string& assetDir, int windowWidth, int windowHeight, int tilesVertically)
 : renderer(renderer), worldId(worldId), assetDir(assetDir), windowWidth(windowWidth), windowHeight(windowHeight), tilesVertically(tilesVertically), showPolygonOutlines(false) {
@@ -16,94 +23,218 @@ Level::Level(SDL_Renderer* renderer, b2WorldId worldId, std::string& assetDir, i
     offsetX = windowWidth / PIXELS_PER_METER / 2.0F;
     offsetY = windowHeight / PIXELS_PER_METER / 2.0F;
     
-    spdlog::debug("Level initialized with scale: {}, offsetX: {}, offsetY: {}", scale, offsetX, offsetY);
+    LOG_DEBUG(LogSubsystem::Level, "Level initialized with scale: {}, offsetX: {}, offsetY: {}", scale, offsetX, offsetY);
 }
 
 Level::~Level() = default;
 
-auto Level::loadTilemap(const std::string& filename) -> bool {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        spdlog::error("Failed to open tilemap file: {}", filename);
+auto Level::loadTilemap(const std::string& filename, AssetCache& assets) -> bool {
+    std::string contents;
+    if (!AssetFileSystem::readText(filename, contents)) {
+        getLogger(LogSubsystem::Level)->error("Failed to open tilemap file: {}", filename);
         return false;
     }
-    nlohmann::json tilemap;
-    file >> tilemap;
-    
-    int mapHeight = tilemap["height"];
-    int mapWidth = tilemap["width"];
-    tileWidth = tilemap["tilewidth"];
-    tileHeight = tilemap["tileheight"];
-    
-    std::vector<std::vector<int>> tileData(mapHeight, std::vector<int>(mapWidth, 0));
-    for (const auto& layer : tilemap["layers"]) {
-        if (layer["type"] == "tilelayer") {
-            const auto& data = layer["data"];
-            for (int y = 0; y < mapHeight; ++y) {
-                for (int x = 0; x < mapWidth; ++x) {
-                    tileData[y][x] = data[(y * mapWidth) + x];
+    TilemapData map;
+    std::string error;
+    if (!parseTilemap(contents, map, error)) {
+        getLogger(LogSubsystem::Level)->error("Invalid tilemap {}: {}", filename, error);
+        return false;
+    }
+
+    applyTilemap(map, assets);
+    getLogger(LogSubsystem::Level)->info("Tilemap loaded successfully from file: {}", filename);
+    return true;
+}
+
+auto Level::parseTilemap(const std::string& contents, TilemapData& map, std::string& error) -> bool {
+    nlohmann::json tilemap = nlohmann::json::parse(contents, nullptr, false);
+    if (tilemap.is_discarded()) {
+        error = "not valid JSON";
+        return false;
+    }
+
+    try {
+        map.width = tilemap.at("width");
+        map.height = tilemap.at("height");
+        map.tileWidth = tilemap.at("tilewidth");
+        map.tileHeight = tilemap.at("tileheight");
+        if (map.width <= 0 || map.height <= 0 || map.tileWidth <= 0 || map.tileHeight <= 0) {
+            error = "map and tile sizes must be positive";
+            return false;
+        }
+
+        const size_t tileCount = static_cast<size_t>(map.width) * static_cast<size_t>(map.height);
+        map.tiles.clear();
+        for (const auto& layer : tilemap.at("layers")) {
+            if (layer.value("type", "") == "tilelayer") {
+                const auto& data = layer.at("data");
+                if (!data.is_array() || data.size() != tileCount) {
+                    error = fmt::format("tile layer has {} entries, expected {}", data.size(), tileCount);
+                    return false;
                 }
+                map.tiles = data.get<std::vector<int>>();
             }
         }
+        if (map.tiles.empty()) {
+            error = "no tile layer";
+            return false;
+        }
+    } catch (const nlohmann::json::exception& e) {
+        error = e.what();
+        return false;
     }
+    return true;
+}
+
+auto Level::applyTilemap(const TilemapData& map, AssetCache& assets) -> size_t {
+    // Island cells are grid coordinates, so islands only carry over while the map keeps its size
+    if (map.width != mapWidth || map.height != mapHeight || map.tileWidth != static_cast<int>(tileWidth) || map.tileHeight != static_cast<int>(tileHeight)) {
+        for (LevelIsland& island : islands) {
+            destroyIsland(island);
+        }
+        islands.clear();
+    }
+    mapWidth = map.width;
+    mapHeight = map.height;
+    tileWidth = map.tileWidth;
+    tileHeight = map.tileHeight;
+
+    // All scratch data for the build below comes from this arena and is released in one go on return.
+    // The initial block covers the grids and tile lists of a typical map; it grows if that is not enough.
+    const AllocationCounters allocationsBefore = AllocationTracker::getTotals();
+    const size_t tileCount = static_cast<size_t>(mapWidth) * static_cast<size_t>(mapHeight);
+    std::pmr::monotonic_buffer_resource scratch(LOAD_ARENA_BYTES_PER_TILE * std::max<size_t>(tileCount, 1));
+
+    TileGrid<int> tileData(mapWidth, mapHeight, &scratch);
+    std::copy(map.tiles.begin(), map.tiles.end(), tileData.cells.begin());
     
-    std::vector<std::vector<bool>> visited(mapHeight, std::vector<bool>(mapWidth, false));
+    // Request every tile image first so they are decoded in one parallel batch
+    std::map<std::string, SDL_Texture*> tileTextures;
+    for (int tile : tileData.cells) {
+        if (const char* type = tileType(tile)) {
+            tileTextures.try_emplace(type, nullptr);
+        }
+    }
+    auto tilePath = [this](const std::string& type) { return assetDir + "/tiles/" + type + ".png"; };
+    for (const auto& [type, texture] : tileTextures) {
+        assets.request(tilePath(type), AssetUsage::Texture);
+    }
+    assets.loadPending();
+    for (auto& [type, texture] : tileTextures) {
+        texture = assets.getTexture(tilePath(type));
+    }
+
+    constexpr std::array<std::pair<int, int>, 4> directions = {{{0, 1}, {1, 0}, {0, -1}, {-1, 0}}};
+    auto isSolid = [&tileData](int x, int y) { return tileData.at(x, y) == 1 || tileData.at(x, y) == 2; };
+
+    // Breadth-first order only depends on an island's cells, and its first cell is where the
+    // row-major scan below enters it, so an unchanged island is found by its first cell
+    TileGrid<int> existingIslands(mapWidth, mapHeight, &scratch); // 1-based index into islands
+    for (size_t i = 0; i < islands.size(); ++i) {
+        const auto [cy, cx] = islands[i].cells.front();
+        existingIslands.at(cx, cy) = static_cast<int>(i) + 1;
+    }
+    std::pmr::vector<uint8_t> kept(islands.size(), 0, &scratch);
+    auto isUnchanged = [&](const LevelIsland& island, std::span<const std::pair<int, int>> cells) {
+        if (!std::equal(island.cells.begin(), island.cells.end(), cells.begin(), cells.end())) {
+            return false;
+        }
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (island.tileIds[i] != tileData.at(cells[i].second, cells[i].first)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<LevelIsland> built;
+    TileGrid<uint8_t> visited(mapWidth, mapHeight, &scratch);
+    TileGrid<uint8_t> traced(mapWidth, mapHeight, &scratch);
+    TileGrid<uint8_t> members(mapWidth, mapHeight, &scratch);
+    // Tiles of the current island in breadth-first order; the unprocessed tail doubles as the BFS queue
+    std::pmr::vector<std::pair<int, int>> chainTiles(&scratch);
+    chainTiles.reserve(tileCount);
     for (int y = 0; y < mapHeight; ++y) {
         for (int x = 0; x < mapWidth; ++x) {
-            if ((tileData[y][x] == 1 || tileData[y][x] == 2) && !visited[y][x]) {
-                std::vector<b2Vec2> chainPoints;
-                std::vector<std::pair<int, int>> chainTiles;
-                std::queue<std::pair<int, int>> q;
-                q.push({y, x});
-                visited[y][x] = true;
+            if (isSolid(x, y) && visited.at(x, y) == 0) {
+                chainTiles.clear();
+                chainTiles.push_back({y, x});
+                visited.at(x, y) = 1;
                 
-                while (!q.empty()) {
-                    auto [cy, cx] = q.front();
-                    q.pop();
-                    
-                    float left = static_cast<float>(cx * tileWidth) / PIXELS_PER_METER;
-                    float right = static_cast<float>((cx + 1) * tileWidth) / PIXELS_PER_METER;
-                    float top = static_cast<float>((mapHeight - cy - 1) * tileHeight) / PIXELS_PER_METER;
-                    float bottom = static_cast<float>((mapHeight - cy) * tileHeight) / PIXELS_PER_METER;
-                    
-                    chainPoints.push_back(b2Vec2{left, top});
-                    chainPoints.push_back(b2Vec2{right, top});
-                    chainPoints.push_back(b2Vec2{right, bottom});
-                    chainPoints.push_back(b2Vec2{left, bottom});
-                    
-                    chainTiles.push_back({cy, cx});
-                    
-                    std::string tileType = (tileData[cy][cx] == 1) ? "ground" : "rectangle";
-                    createTile(tileType, cx * tileWidth, (mapHeight - cy - 1) * tileHeight, false);
+                for (size_t next = 0; next < chainTiles.size(); ++next) {
+                    auto [cy, cx] = chainTiles[next];
                     
                     // Check adjacent tiles
-                    std::vector<std::pair<int, int>> directions = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
                     for (const auto& [dy, dx] : directions) {
                         int ny = cy + dy;
                         int nx = cx + dx;
-                        if (ny >= 0 && ny < mapHeight && nx >= 0 && nx < mapWidth && (tileData[ny][nx] == 1 || tileData[ny][nx] == 2) && !visited[ny][nx]) {
-                            q.push({ny, nx});
-                            visited[ny][nx] = true;
+                        if (tileData.contains(nx, ny) && isSolid(nx, ny) && visited.at(nx, ny) == 0) {
+                            chainTiles.push_back({ny, nx});
+                            visited.at(nx, ny) = 1;
                         }
                     }
                 }
-                
-                if (!chainPoints.empty()) {
-                    createChainForStaticTiles(chainTiles, mapHeight);
+
+                const int existing = existingIslands.at(x, y);
+                if (existing != 0 && isUnchanged(islands[existing - 1], chainTiles)) {
+                    kept[existing - 1] = 1;
+                    continue;
+                }
+
+                LevelIsland& island = built.emplace_back();
+                island.cells.assign(chainTiles.begin(), chainTiles.end());
+                island.tileIds.reserve(chainTiles.size());
+                for (const auto& [cy, cx] : chainTiles) {
+                    island.tileIds.push_back(tileData.at(cx, cy));
+                    const std::string type = tileType(tileData.at(cx, cy));
+                    createTile(type, tileTextures[type], cx * tileWidth, (mapHeight - cy - 1) * tileHeight, false, island);
                 }
+                
+                createChainForStaticTiles(chainTiles, mapHeight, members, traced, &scratch, island);
             }
         }
     }
+
+    const size_t rebuilt = built.size();
+    for (size_t i = 0; i < islands.size(); ++i) {
+        if (kept[i] != 0) {
+            built.push_back(std::move(islands[i]));
+        } else {
+            destroyIsland(islands[i]);
+        }
+    }
+    islands = std::move(built);
+
+    // One-way and slope tiles have no Box2D geometry, so they are not part of any island
+    passableTiles.clear();
+    for (int y = 0; y < mapHeight; ++y) {
+        for (int x = 0; x < mapWidth; ++x) {
+            const int tile = tileData.at(x, y);
+            if (!isSolid(x, y) && tileType(tile) != nullptr) {
+                const std::string type = tileType(tile);
+                passableTiles.push_back(std::make_shared<Tile>(renderer, type, b2_nullBodyId, b2_nullChainId, b2_nullShapeId, tileWidth, tileHeight, tileTextures[type],
+                                                               static_cast<int>(static_cast<float>(x * tileWidth) / PIXELS_PER_METER),
+                                                               static_cast<int>(static_cast<float>((mapHeight - y - 1) * tileHeight) / PIXELS_PER_METER)));
+            }
+        }
+    }
+    collectIslands();
+    collisionGrid.build(map);
     
-    spdlog::info("Tilemap loaded successfully from file: {}", filename);
-    return true;
+    LOG_DEBUG(LogSubsystem::Level, "Built {} of {} islands", rebuilt, islands.size());
+    if (AllocationTracker::isEnabled()) {
+        const AllocationCounters allocations = AllocationTracker::getTotals() - allocationsBefore;
+        getLogger(LogSubsystem::Level)->info("Level build made {} heap allocations ({} tiles)", allocations.allocations, tiles.size());
+    }
+    return rebuilt;
 }
 
 void Level::render() {
+    const CameraTransform camera = getCamera();
     for (const auto& tile : tiles) {
-        tile->render(scale, offsetX, offsetY, windowWidth, windowHeight);
+        tile->render(camera);
         if (showPolygonOutlines) {
-            tile->renderPolygonOutline(scale, offsetX, offsetY, windowWidth, windowHeight);
+            tile->renderPolygonOutline(camera);
         }
     }
 }
@@ -114,7 +245,7 @@ void Level::handleErrors() {
 
 void Level::setScale(float newScale) {
     scale = newScale;
-    spdlog::debug("Scale set to: {}", scale);
+    LOG_DEBUG(LogSubsystem::Level, "Scale set to: {}", scale);
 }
 
 float Level::getScale() const {
@@ -124,7 +255,16 @@ float Level::getScale() const {
 void Level::setViewportCenter(float centerX, float centerY) {
     offsetX = centerX;
     offsetY = centerY;
-    spdlog::debug("Viewport center set to: ({}, {})", centerX, centerY);
+    LOG_DEBUG(LogSubsystem::Level, "Viewport center set to: ({}, {})", centerX, centerY);
+}
+
+// Resizes the area the camera renders into and re-centres it the same way the constructor does
+void Level::setViewportSize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    offsetX = windowWidth / PIXELS_PER_METER / 2.0F;
+    offsetY = windowHeight / PIXELS_PER_METER / 2.0F;
+    LOG_DEBUG(LogSubsystem::Level, "Viewport size set to: {}x{}", width, height);
 }
 
 auto Level::getOffsetX() const -> float {
@@ -135,11 +275,27 @@ auto Level::getOffsetY() const -> float {
     return offsetY;
 }
 
+auto Level::getCamera() const -> CameraTransform {
+    return CameraTransform(scale, offsetX, offsetY, windowWidth, windowHeight);
+}
+
+auto Level::getStaticOutlines() const -> const std::vector<std::vector<b2Vec2>>& {
+    return staticOutlines;
+}
+
+auto Level::getStaticChainVertexCount() const -> size_t {
+    size_t count = 0;
+    for (const auto& outline : staticOutlines) {
+        count += outline.size();
+    }
+    return count;
+}
+
 void Level::setShowPolygonOutlines(bool show) {
     showPolygonOutlines = show;
 }
 
-void Level::createTile(const std::string& type, int x, int y, bool isDynamic) {
+void Level::createTile(const std::string& type, SDL_Texture* texture, int x, int y, bool isDynamic, LevelIsland& island) {
     b2BodyDef bodyDef = b2DefaultBodyDef();
     bodyDef.type = isDynamic ? b2_dynamicBody : b2_staticBody;
     bodyDef.position = b2Vec2{static_cast<float>(x) / PIXELS_PER_METER, static_cast<float>(y) / PIXELS_PER_METER};
@@ -150,40 +306,74 @@ void Level::createTile(const std::string& type, int x, int y, bool isDynamic) {
     b2ChainId chainId = b2_nullChainId;
     b2ShapeId shapeId = b2_nullShapeId;
     
-    std::shared_ptr<Tile> tile = std::make_shared<Tile>(renderer, type, bodyId, chainId, shapeId, tileWidth, tileHeight, assetDir, bodyDef.position.x, bodyDef.position.y);
-    tiles.push_back(tile);
+    std::shared_ptr<Tile> tile = std::make_shared<Tile>(renderer, type, bodyId, chainId, shapeId, tileWidth, tileHeight, texture, bodyDef.position.x, bodyDef.position.y);
+    island.bodies.push_back(bodyId);
+    island.tiles.push_back(tile);
     
-    spdlog::debug("Tile created: type = {}, position = ({}, {}), isDynamic = {}", type, x, y, isDynamic);
+    LOG_TRACE(LogSubsystem::Level, "Tile created: type = {}, position = ({}, {}), isDynamic = {}", type, x, y, isDynamic);
 }
 
-bool Level::isSolidTile(int x, int y, const std::vector<std::pair<int, int>>& chainTiles) {
-    for (const auto& [cy, cx] : chainTiles) {
-        if (cx == x && cy == y) return true;
+void Level::destroyIsland(LevelIsland& island) {
+    for (b2BodyId bodyId : island.bodies) {
+        if (b2Body_IsValid(bodyId)) {
+            b2DestroyBody(bodyId);
+        }
+    }
+    island.bodies.clear();
+    island.tiles.clear();
+    island.outlines.clear();
+}
+
+void Level::collectIslands() {
+    tiles.clear();
+    staticOutlines.clear();
+    for (const LevelIsland& island : islands) {
+        tiles.insert(tiles.end(), island.tiles.begin(), island.tiles.end());
+        staticOutlines.insert(staticOutlines.end(), island.outlines.begin(), island.outlines.end());
     }
-    return false;
+    tiles.insert(tiles.end(), passableTiles.begin(), passableTiles.end());
+}
+
+// There is no art for one-way or slope tiles yet, so they reuse the rectangle
+auto Level::tileType(int tileId) -> const char* {
+    switch (tileId) {
+        case 1:
+            return "ground";
+        case 2:
+        case 3:
+        case 4:
+        case 5:
+            return "rectangle";
+        default:
+            return nullptr;
+    }
+}
+
+bool Level::isSolidTile(int x, int y, const TileGrid<uint8_t>& members) {
+    return members.contains(x, y) && members.at(x, y) != 0;
 }
 
-std::tuple<int, int, int> Level::findStartingTile(const std::vector<std::pair<int, int>>& chainTiles, const std::vector<std::vector<bool>>& visited) {
+std::tuple<int, int, int> Level::findStartingTile(std::span<const std::pair<int, int>> chainTiles, const TileGrid<uint8_t>& members, const TileGrid<uint8_t>& visited) {
     // Directions for checking neighbors (clockwise)
-    const std::vector<std::pair<int, int>> directions = {
+    constexpr std::array<std::pair<int, int>, 4> directions = {{
         {0, 1},  // East
         {1, 0},  // South
         {0, -1}, // West
         {-1, 0}  // North
-    };
+    }};
     
     // Mapping from 4-direction index to 8-direction index
-    const std::vector<int> directionMapping = {3, 1, 7, 5};
+    constexpr std::array<int, 4> directionMapping = {3, 1, 7, 5};
     
     for (const auto& [cy, cx] : chainTiles) {
-        if (!visited[cy][cx]) {
+        if (visited.at(cx, cy) == 0) {
             // Check if the tile is on the border
             for (int i = 0; i < directions.size(); ++i) {
                 int ny = cy + directions[i].first;
                 int nx = cx + directions[i].second;
                 
                 // Check if the neighbor is out of bounds or not in the chainTiles list
-                if (ny < 0 || ny >= visited.size() || nx < 0 || nx >= visited[0].size() || !isSolidTile(nx, ny, chainTiles)) {
+                if (!isSolidTile(nx, ny, members)) {
                     // Return the starting tile coordinates and the direction pointing towards the empty tile
                     return {cy, cx, directionMapping[i]}; // Map to the corresponding 8-direction index
                 }
@@ -193,23 +383,23 @@ std::tuple<int, int, int> Level::findStartingTile(const std::vector<std::pair<in
     return {-1, -1, -1};
 }
 
-std::pair<std::vector<std::pair<int, int>>, std::vector<b2Vec2>> Level::traceBorder(int startX, int startY, int startDir, const std::vector<std::pair<int, int>>& chainTiles, std::vector<std::vector<bool>>& visited, int mapHeight, int tileWidth, int tileHeight) {
-    std::vector<std::pair<int, int>> outlineTiles;
-    std::vector<b2Vec2> outlineVertices;
+std::pair<std::pmr::vector<std::pair<int, int>>, std::pmr::vector<b2Vec2>> Level::traceBorder(int startX, int startY, int startDir, const TileGrid<uint8_t>& members, TileGrid<uint8_t>& visited, int mapHeight, int tileWidth, int tileHeight, std::pmr::memory_resource* scratch) {
+    std::pmr::vector<std::pair<int, int>> outlineTiles(scratch);
+    std::pmr::vector<b2Vec2> outlineVertices(scratch);
     int x = startX, y = startY;
     int dir = startDir; // Start with the initial direction
     
     // Directions for Moore-Neighbor Tracing (counter-clockwise)
-    const std::vector<std::pair<int, int>> directions = {
+    constexpr std::array<std::pair<int, int>, 8> directions = {{
         {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}
-    };
+    }};
     
-    std::set<int> firstTileDirections;
+    uint8_t firstTileDirections = 0; // Bit per direction the start tile has been entered from
     bool isFirstTile = true;
     bool finishedTracing = false;
     
     do {
-        visited[y][x] = true;
+        visited.at(x, y) = 1;
         outlineTiles.push_back({y, x});
         bool found = false;
         
@@ -218,7 +408,7 @@ std::pair<std::vector<std::pair<int, int>>, std::vector<b2Vec2>> Level::traceBor
             int nx = x + directions[newDir].first;
             int ny = y + directions[newDir].second;
             
-            if(!isSolidTile(nx, ny, chainTiles))
+            if(!isSolidTile(nx, ny, members))
             {
                 if (newDir == 5) { // North
                     outlineVertices.push_back(b2Vec2{static_cast<float>(x + 1.0f), static_cast<float>((mapHeight - y))});
@@ -249,11 +439,11 @@ std::pair<std::vector<std::pair<int, int>>, std::vector<b2Vec2>> Level::traceBor
                 isFirstTile = (x == startX && y == startY);
 
                 if (isFirstTile) {
-                    if (firstTileDirections.find(dir) != firstTileDirections.end()) {
+                    if ((firstTileDirections & (1U << dir)) != 0) {
                         finishedTracing = true;
                         break;
                     } else {
-                        firstTileDirections.insert(dir);
+                        firstTileDirections |= static_cast<uint8_t>(1U << dir);
                     }
                 }
                 break;
@@ -267,30 +457,26 @@ std::pair<std::vector<std::pair<int, int>>, std::vector<b2Vec2>> Level::traceBor
         }
     } while (!finishedTracing);
     
-    return {outlineTiles, outlineVertices};
+    // A copy of a pmr vector would use the default resource, not the arena
+    return {std::move(outlineTiles), std::move(outlineVertices)};
 }
 
-void Level::createChainForStaticTiles(const std::vector<std::pair<int, int>>& chainTiles, int mapHeight) {
+void Level::createChainForStaticTiles(std::span<const std::pair<int, int>> chainTiles, int mapHeight, TileGrid<uint8_t>& members, TileGrid<uint8_t>& traced, std::pmr::memory_resource* scratch, LevelIsland& island) {
     if (chainTiles.empty()) return;
-    
-    // Determine the maximum width of the map
-    int mapWidth = 0;
+
+    // Constant-time membership tests for the tracing below
     for (const auto& [cy, cx] : chainTiles) {
-        if (cx > mapWidth) mapWidth = cx;
+        members.at(cx, cy) = 1;
     }
-    mapWidth += 1; // Adjust for 0-based indexing
-    
-    // Initialize visited tiles
-    std::vector<std::vector<bool>> visited(mapHeight, std::vector<bool>(mapWidth, false));
     
     // Find and trace all islands
     while (true) {
-        auto [startY, startX, startDir] = findStartingTile(chainTiles, visited);
+        auto [startY, startX, startDir] = findStartingTile(chainTiles, members, traced);
         if (startX == -1 && startY == -1) break; // No more unvisited tiles
         
-        spdlog::debug("Tracing border starting at ({}, {})", startX, startY);
-        auto [outlineTiles, outlineVertices] = traceBorder(startX, startY, startDir, chainTiles, visited, mapHeight, tileWidth, tileHeight);
-        spdlog::debug("Border traced with {} points", outlineVertices.size());
+        LOG_DEBUG(LogSubsystem::Level, "Tracing border starting at ({}, {})", startX, startY);
+        auto [outlineTiles, outlineVertices] = traceBorder(startX, startY, startDir, members, traced, mapHeight, tileWidth, tileHeight, scratch);
+        LOG_DEBUG(LogSubsystem::Level, "Border traced with {} points", outlineVertices.size());
         
         // Create the body and chain shape
         b2BodyDef bodyDef = b2DefaultBodyDef();
@@ -306,19 +492,26 @@ void Level::createChainForStaticTiles(const std::vector<std::pair<int, int>>& ch
         
         b2ChainId chainId = b2CreateChain(bodyId, &chainDef);
         b2ShapeId shapeId = b2_nullShapeId;
+        island.bodies.push_back(bodyId);
+        island.outlines.emplace_back(outlineVertices.begin(), outlineVertices.end());
         
         // Update the tiles to reference the chain shape
-        for (const auto& [cy, cx] : chainTiles) {
-            if (visited[cy][cx]) {
-                for (auto& tile : tiles) {
-                    if (tile->getX() == cx * tileWidth && tile->getY() == (mapHeight - cy - 1) * tileHeight) {
-                        tile = std::make_shared<Tile>(renderer, tile->getType(), bodyId, chainId, shapeId, tileWidth, tileHeight, assetDir, cx * tileWidth, (mapHeight - cy - 1) * tileHeight);
-                    }
-                }
+        for (size_t i = 0; i < chainTiles.size(); ++i) {
+            const auto [cy, cx] = chainTiles[i];
+            if (traced.at(cx, cy) != 0) {
+                // Keep the tile where createTile put it, in metres
+                std::shared_ptr<Tile>& tile = island.tiles[i];
+                tile = std::make_shared<Tile>(renderer, tile->getType(), bodyId, chainId, shapeId, tileWidth, tileHeight, tile->getTexture(), tile->getX(), tile->getY());
             }
         }
         
-        spdlog::debug("Chain created with {} points", outlineVertices.size());
+        LOG_DEBUG(LogSubsystem::Level, "Chain created with {} points", outlineVertices.size());
+    }
+
+    // Only this island's tiles can have been marked, so resetting them leaves the grid clean for the next one
+    for (const auto& [cy, cx] : chainTiles) {
+        traced.at(cx, cy) = 0;
+        members.at(cx, cy) = 0;
     }
 }
 
@@ -334,5 +527,5 @@ void Level::update(float deltaTime, const b2Vec2& characterPosition) {
     offsetX = std::clamp(offsetX, windowWidth / (2.0F * PIXELS_PER_METER), levelWidth - (windowWidth / (2.0F * PIXELS_PER_METER)));
     offsetY = std::clamp(offsetY, windowHeight / (2.0F * PIXELS_PER_METER), levelHeight - (windowHeight / (2.0F * PIXELS_PER_METER)));
     
-    spdlog::debug("Level updated: deltaTime = {}, characterPosition = ({}, {})", deltaTime, characterPosition.x, characterPosition.y);
+    LOG_TRACE(LogSubsystem::Level, "Level updated: deltaTime = {}, characterPosition = ({}, {})", deltaTime, characterPosition.x, characterPosition.y);
 }
@@ -4,35 +4,96 @@
 #include <box2d/box2d.h>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <cstdint>
 #include "Tile.h"
+#include "CameraTransform.h"
+#include "KinematicController.h"
+
+class AssetCache;
+
+// Row-major grid over the tilemap. The grids used while building the level
+// take their storage from the load arena.
+template <typename T>
+struct TileGrid {
+    TileGrid(int width, int height, std::pmr::memory_resource* resource)
+        : width(width), height(height), cells(static_cast<size_t>(width) * static_cast<size_t>(height), T{}, resource) {}
+
+    [[nodiscard]] auto contains(int x, int y) const -> bool { return x >= 0 && x < width && y >= 0 && y < height; }
+    auto at(int x, int y) -> T& { return cells[(static_cast<size_t>(y) * width) + x]; }
+    [[nodiscard]] auto at(int x, int y) const -> const T& { return cells[(static_cast<size_t>(y) * width) + x]; }
+
+    int width;
+    int height;
+    std::pmr::vector<T> cells;
+};
+
+// Parsed and validated .tmj contents. Plain data, so it can be produced on a
+// background thread and handed to the main thread for a rebuild.
+struct TilemapData {
+    int width = 0;
+    int height = 0;
+    int tileWidth = 0;
+    int tileHeight = 0;
+    std::vector<int> tiles; // Row-major tile ids of the last tile layer
+};
+
+// One connected group of solid tiles and the static bodies built for it
+struct LevelIsland {
+    std::vector<std::pair<int, int>> cells; // (y, x) in breadth-first order from the top-left cell
+    std::vector<int> tileIds;               // Parallel to cells
+    std::vector<b2BodyId> bodies;
+    std::vector<std::shared_ptr<Tile>> tiles;
+    std::vector<std::vector<b2Vec2>> outlines;
+};
 
 class Level {
 public:
     Level(SDL_Renderer* renderer, b2WorldId worldId, std::string& assetDir, int windowWidth, int windowHeight, int tilesVertically);
     ~Level();
 
-    auto loadTilemap(const std::string& filename) -> bool;
+    // Tile images are requested from the cache and decoded together with anything already pending
+    auto loadTilemap(const std::string& filename, AssetCache& assets) -> bool;
+    // Fails with a message instead of throwing on malformed or inconsistent maps
+    static auto parseTilemap(const std::string& contents, TilemapData& map, std::string& error) -> bool;
+    // Rebuilds only the islands (connected groups of solid tiles) that differ from the
+    // current level; returns how many were rebuilt. Everything is rebuilt if the map size changed.
+    auto applyTilemap(const TilemapData& map, AssetCache& assets) -> size_t;
     void render();
     void handleErrors();
-    std::tuple<int, int, int> findStartingTile(const std::vector<std::pair<int, int>>& chainTiles, const std::vector<std::vector<bool>>& visited);
-    std::pair<std::vector<std::pair<int, int>>, std::vector<b2Vec2>> traceBorder(int startX, int startY, int startDir, const std::vector<std::pair<int, int>>& chainTiles, std::vector<std::vector<bool>>& visited, int mapHeight, int tileWidth, int tileHeight);
-    void createChainForStaticTiles(const std::vector<std::pair<int, int>> &chainTiles, int mapHeight);
+    // members marks the tiles of the island being traced
+    std::tuple<int, int, int> findStartingTile(std::span<const std::pair<int, int>> chainTiles, const TileGrid<uint8_t>& members, const TileGrid<uint8_t>& visited);
+    std::pair<std::pmr::vector<std::pair<int, int>>, std::pmr::vector<b2Vec2>> traceBorder(int startX, int startY, int startDir, const TileGrid<uint8_t>& members, TileGrid<uint8_t>& visited, int mapHeight, int tileWidth, int tileHeight, std::pmr::memory_resource* scratch);
+    // members and traced must be all zero on entry and are left that way; scratch memory is only released by the caller.
+    // island.tiles must hold one tile per entry of chainTiles, in the same order.
+    void createChainForStaticTiles(std::span<const std::pair<int, int>> chainTiles, int mapHeight, TileGrid<uint8_t>& members, TileGrid<uint8_t>& traced, std::pmr::memory_resource* scratch, LevelIsland& island);
     void update(float deltaTime, const b2Vec2& characterPosition);
 
     void setScale(float newScale);
     void setViewportCenter(float centerX, float centerY);
+    void setViewportSize(int width, int height);
 
     [[nodiscard]] auto getScale() const -> float;
     [[nodiscard]] auto getOffsetX() const -> float;
     [[nodiscard]] auto getOffsetY() const -> float;
+    [[nodiscard]] auto getCamera() const -> CameraTransform;
+    [[nodiscard]] auto getStaticOutlines() const -> const std::vector<std::vector<b2Vec2>>&;
+    [[nodiscard]] auto getStaticChainVertexCount() const -> size_t;
+    // Rebuilt in place by applyTilemap, so a pointer to it stays valid across reloads
+    [[nodiscard]] auto getCollisionGrid() const -> const TileCollisionGrid& { return collisionGrid; }
 
     void setShowPolygonOutlines(bool show);
 
 private:
-    void createTile(const std::string& type, int x, int y, bool isDynamic);
-    bool isSolidTile(int x, int y, const std::vector<std::pair<int, int>> &chainTiles);
+    void createTile(const std::string& type, SDL_Texture* texture, int x, int y, bool isDynamic, LevelIsland& island);
+    void destroyIsland(LevelIsland& island);
+    // Refreshes tiles and staticOutlines from the islands and passable tiles
+    void collectIslands();
+    // Texture name of a tile id, or nullptr for empty cells
+    static auto tileType(int tileId) -> const char*;
+    static bool isSolidTile(int x, int y, const TileGrid<uint8_t>& members);
     void initializeDebugDraw();
 
     SDL_Renderer* renderer;
@@ -48,7 +109,13 @@ private:
 
     uint32_t tileWidth;
     uint32_t tileHeight;
-    
+    int mapWidth = 0;
+    int mapHeight = 0;
+
+    std::vector<LevelIsland> islands;
+    std::vector<std::shared_ptr<Tile>> passableTiles; // Drawn only; kinematic characters collide with them through collisionGrid
     std::vector<std::shared_ptr<Tile>> tiles;
+    std::vector<std::vector<b2Vec2>> staticOutlines;
+    TileCollisionGrid collisionGrid;
     bool showPolygonOutlines;
 };
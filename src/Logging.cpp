@@ -0,0 +1,104 @@
+#include "Logging.h"
+#include "Config.h"
+#include <spdlog/async.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <sstream>
+
+namespace {
+
+constexpr size_t LOG_QUEUE_SIZE = 8192;
+constexpr size_t LOG_WORKER_THREADS = 1;
+
+constexpr std::array<const char*, static_cast<size_t>(LogSubsystem::Count)> SUBSYSTEM_NAMES = {
+    "game", "level", "character", "physics", "render", "assets"
+};
+
+std::array<spdlog::logger*, static_cast<size_t>(LogSubsystem::Count)> loggers{};
+
+} // namespace
+
+void initializeLogging() {
+    spdlog::init_thread_pool(LOG_QUEUE_SIZE, LOG_WORKER_THREADS);
+
+    // Create a console sink
+    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    console_sink->set_level(spdlog::level::trace);
+    console_sink->set_pattern("[%H:%M:%S] [%^%l%$] [" + std::string(PROJECT_NAME) + "] [%n] %v");
+
+    // Create a file sink with log rotation
+    auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>("logs/logfile.log", 1048576 * 5, 3);
+    file_sink->set_level(spdlog::level::trace);
+    file_sink->set_pattern("[%H:%M:%S] [%l] [" + std::string(PROJECT_NAME) + "] [%n] %v");
+
+    const spdlog::sinks_init_list sinks = {console_sink, file_sink};
+    for (size_t i = 0; i < SUBSYSTEM_NAMES.size(); ++i) {
+        auto logger = std::make_shared<spdlog::async_logger>(SUBSYSTEM_NAMES[i], sinks, spdlog::thread_pool(),
+                                                             spdlog::async_overflow_policy::overrun_oldest);
+        // Trace output (per tile, per frame) is opt-in through applyLogLevels
+        logger->set_level(static_cast<spdlog::level::level_enum>(std::max(SPDLOG_ACTIVE_LEVEL, SPDLOG_LEVEL_DEBUG)));
+        // Writes happen on the worker thread; only warnings and errors force a flush
+        logger->flush_on(spdlog::level::warn);
+        spdlog::register_logger(logger);
+        loggers[i] = logger.get();
+    }
+
+    // Set the game logger as the default logger
+    spdlog::set_default_logger(spdlog::get(SUBSYSTEM_NAMES[static_cast<size_t>(LogSubsystem::Game)]));
+    spdlog::flush_every(std::chrono::seconds(1));
+}
+
+void shutdownLogging() {
+    if (auto pool = spdlog::thread_pool()) {
+        size_t dropped = pool->overrun_counter();
+        if (dropped > 0) {
+            spdlog::warn("Dropped {} log messages because the log queue was full", dropped);
+        }
+    }
+    loggers.fill(nullptr);
+    spdlog::shutdown();
+}
+
+auto applyLogLevels(const std::string& spec) -> bool {
+    std::stringstream stream(spec);
+    std::string entry;
+    bool valid = true;
+    while (std::getline(stream, entry, ',')) {
+        size_t separator = entry.find('=');
+        if (separator == std::string::npos) {
+            spdlog::error("Invalid log level entry '{}', expected subsystem=level", entry);
+            valid = false;
+            continue;
+        }
+        std::string name = entry.substr(0, separator);
+        std::string levelName = entry.substr(separator + 1);
+        spdlog::level::level_enum level = spdlog::level::from_str(levelName);
+        // from_str maps unknown names to off, so only a literal "off" may turn a logger off
+        if (level == spdlog::level::off && levelName != spdlog::level::to_string_view(spdlog::level::off)) {
+            spdlog::error("Unknown log level '{}' for '{}'", levelName, name);
+            valid = false;
+            continue;
+        }
+        auto logger = spdlog::get(name);
+        if (logger == nullptr) {
+            spdlog::error("Unknown log subsystem '{}'", name);
+            valid = false;
+            continue;
+        }
+        logger->set_level(level);
+        if (level < SPDLOG_ACTIVE_LEVEL) {
+            spdlog::warn("Log level {} for '{}' is below the compiled-in level; those messages are stripped from this build",
+                         spdlog::level::to_string_view(level), name);
+        }
+    }
+    return valid;
+}
+
+auto getLogger(LogSubsystem subsystem) -> spdlog::logger* {
+    spdlog::logger* logger = loggers[static_cast<size_t>(subsystem)];
+    // Tools that never call initializeLogging log everything through the default logger
+    return logger != nullptr ? logger : spdlog::default_logger_raw();
+}
@@ -1,27 +1,34 @@
 #pragma once
 
+// SPDLOG_ACTIVE_LEVEL is set per configuration by CMake; trace/debug macros below it compile to nothing
+#ifndef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/rotating_file_sink.h>
-#include "Config.h"
+#include <string>
+
+enum class LogSubsystem {
+    Game,
+    Level,
+    Character,
+    Physics,
+    Render,
+    Assets,
+    Count
+};
 
-inline void initializeLogging() {
-    // Create a console sink
-    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    console_sink->set_level(spdlog::level::debug);
-    console_sink->set_pattern("[%H:%M:%S] [%^%l%$] [" + std::string(PROJECT_NAME) + "] %v");
+// Installs async loggers (one per subsystem, shared sinks and worker thread)
+// with a bounded queue that drops the oldest message instead of blocking the
+// game thread when full. The default logger is the Game subsystem.
+void initializeLogging();
+// Flushes the queue and stops the worker thread
+void shutdownLogging();
 
-    // Create a file sink with log rotation
-    auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>("logs/logfile.log", 1048576 * 5, 3);
-    file_sink->set_level(spdlog::level::debug);
-    file_sink->set_pattern("[%H:%M:%S] [%l] [" + std::string(PROJECT_NAME) + "] %v");
+// Runtime per-subsystem filter, e.g. "level=trace,character=warn"
+auto applyLogLevels(const std::string& spec) -> bool;
 
-    // Create a logger with both sinks
-    spdlog::logger logger("multi_sink", {console_sink, file_sink});
-    logger.set_level(spdlog::level::debug);
+auto getLogger(LogSubsystem subsystem) -> spdlog::logger*;
 
-    // Set the logger as the default logger
-    spdlog::set_default_logger(std::make_shared<spdlog::logger>(logger));
-    spdlog::set_level(spdlog::level::debug); // Set global log level to debug
-    spdlog::flush_on(spdlog::level::debug);  // Flush logs on debug level
-}
+#define LOG_TRACE(subsystem, ...) SPDLOG_LOGGER_TRACE(getLogger(subsystem), __VA_ARGS__)
+#define LOG_DEBUG(subsystem, ...) SPDLOG_LOGGER_DEBUG(getLogger(subsystem), __VA_ARGS__)
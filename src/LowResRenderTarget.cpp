@@ -0,0 +1,64 @@
+#include "LowResRenderTarget.h"
+#include "RenderStats.h"
+#include <algorithm>
+#include <cstdio>
+#include "Logging.h"
+
+LowResRenderTarget::LowResRenderTarget(SDL_Renderer* renderer, int width, int height)
+    : renderer(renderer), width(width), height(height) {
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (texture == nullptr) {
+        getLogger(LogSubsystem::Render)->error("Failed to create {}x{} render target: {}", width, height, SDL_GetError());
+        return;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    getLogger(LogSubsystem::Render)->info("Rendering world at {}x{}", width, height);
+}
+
+LowResRenderTarget::~LowResRenderTarget() {
+    if (texture != nullptr) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void LowResRenderTarget::begin() {
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+}
+
+void LowResRenderTarget::end() {
+    SDL_SetRenderTarget(renderer, nullptr);
+
+    int outputWidth = 0;
+    int outputHeight = 0;
+    SDL_GetRenderOutputSize(renderer, &outputWidth, &outputHeight);
+
+    // Largest integer factor that fits; fall back to a fractional downscale for tiny windows
+    float factor = static_cast<float>(std::min(outputWidth / width, outputHeight / height));
+    if (factor < 1.0F) {
+        factor = std::min(static_cast<float>(outputWidth) / width, static_cast<float>(outputHeight) / height);
+    }
+
+    SDL_FRect dstRect;
+    dstRect.w = width * factor;
+    dstRect.h = height * factor;
+    dstRect.x = static_cast<float>(static_cast<int>((outputWidth - dstRect.w) / 2.0F));
+    dstRect.y = static_cast<float>(static_cast<int>((outputHeight - dstRect.h) / 2.0F));
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_RenderTexture(renderer, texture, nullptr, &dstRect);
+    RenderStats::recordDraw(texture, 4);
+}
+
+auto LowResRenderTarget::parseResolution(const std::string& text, int& outWidth, int& outHeight) -> bool {
+    int parsedWidth = 0;
+    int parsedHeight = 0;
+    if (std::sscanf(text.c_str(), "%dx%d", &parsedWidth, &parsedHeight) != 2 || parsedWidth <= 0 || parsedHeight <= 0) {
+        return false;
+    }
+    outWidth = parsedWidth;
+    outHeight = parsedHeight;
+    return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+// Fixed-size render target the world is drawn into at 1:1 texel density. It is
+// upscaled to the window once per frame with nearest filtering, by the largest
+// integer factor that fits, so fill cost stays constant at any display resolution.
+class LowResRenderTarget {
+public:
+    LowResRenderTarget(SDL_Renderer* renderer, int width, int height);
+    ~LowResRenderTarget();
+
+    LowResRenderTarget(const LowResRenderTarget&) = delete;
+    auto operator=(const LowResRenderTarget&) -> LowResRenderTarget& = delete;
+
+    [[nodiscard]] auto isValid() const -> bool { return texture != nullptr; }
+    [[nodiscard]] auto getWidth() const -> int { return width; }
+    [[nodiscard]] auto getHeight() const -> int { return height; }
+
+    // Redirect rendering into the low-resolution target
+    void begin();
+    // Restore the window as render target and blit the upscaled image to it
+    void end();
+
+    // Parses "WIDTHxHEIGHT", e.g. "480x270"
+    static auto parseResolution(const std::string& text, int& outWidth, int& outHeight) -> bool;
+
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    int width;
+    int height;
+};
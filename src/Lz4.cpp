@@ -0,0 +1,147 @@
+#include "Lz4.h"
+#include <cstring>
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5; // The block must end with at least this many literals
+constexpr size_t MATCH_FIND_LIMIT = 12; // No match may start closer than this to the end
+constexpr size_t MAX_OFFSET = 65535;
+constexpr uint32_t HASH_BITS = 12;
+constexpr uint32_t RUN_MASK = 15;
+
+auto read32(const uint8_t* p) -> uint32_t {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+auto hash(uint32_t sequence) -> uint32_t {
+    return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    for (; length >= 255; length -= 255) {
+        out.push_back(255);
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength) {
+    const size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    const size_t literalToken = literalCount < RUN_MASK ? literalCount : RUN_MASK;
+    const size_t matchToken = matchCode < RUN_MASK ? matchCode : RUN_MASK;
+    out.push_back(static_cast<uint8_t>((literalToken << 4) | matchToken));
+    if (literalCount >= RUN_MASK) {
+        writeLength(out, literalCount - RUN_MASK);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+
+    // The last sequence carries literals only
+    if (matchLength == 0) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= RUN_MASK) {
+        writeLength(out, matchCode - RUN_MASK);
+    }
+}
+
+auto readLength(const uint8_t* source, size_t sourceSize, size_t& ip, size_t& length) -> bool {
+    uint8_t byte = 0;
+    do {
+        if (ip >= sourceSize) {
+            return false;
+        }
+        byte = source[ip++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+auto Lz4::compress(const uint8_t* source, size_t sourceSize) -> std::vector<uint8_t> {
+    std::vector<uint8_t> out;
+    out.reserve(sourceSize + (sourceSize / 255) + 16);
+
+    size_t anchor = 0;
+    if (sourceSize > MATCH_FIND_LIMIT) {
+        std::vector<int64_t> table(size_t{1} << HASH_BITS, -1);
+        const size_t matchLimit = sourceSize - LAST_LITERALS;
+        const size_t findLimit = sourceSize - MATCH_FIND_LIMIT;
+
+        size_t ip = 0;
+        while (ip < findLimit) {
+            const uint32_t sequence = read32(source + ip);
+            const uint32_t slot = hash(sequence);
+            const int64_t candidate = table[slot];
+            table[slot] = static_cast<int64_t>(ip);
+
+            if (candidate < 0 || ip - static_cast<size_t>(candidate) > MAX_OFFSET || read32(source + candidate) != sequence) {
+                ip++;
+                continue;
+            }
+
+            const size_t reference = static_cast<size_t>(candidate);
+            size_t matchLength = MIN_MATCH;
+            while (ip + matchLength < matchLimit && source[reference + matchLength] == source[ip + matchLength]) {
+                matchLength++;
+            }
+            writeSequence(out, source + anchor, ip - anchor, ip - reference, matchLength);
+            ip += matchLength;
+            anchor = ip;
+        }
+    }
+
+    writeSequence(out, source + anchor, sourceSize - anchor, 0, 0);
+    return out;
+}
+
+auto Lz4::decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize) -> bool {
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < sourceSize) {
+        const uint8_t token = source[ip++];
+
+        size_t literalCount = token >> 4;
+        if (literalCount == RUN_MASK && !readLength(source, sourceSize, ip, literalCount)) {
+            return false;
+        }
+        if (literalCount > sourceSize - ip || literalCount > destinationSize - op) {
+            return false;
+        }
+        std::memcpy(destination + op, source + ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+
+        if (ip == sourceSize) {
+            return op == destinationSize;
+        }
+
+        if (sourceSize - ip < 2) {
+            return false;
+        }
+        const size_t offset = source[ip] | (static_cast<size_t>(source[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return false;
+        }
+
+        size_t matchLength = token & RUN_MASK;
+        if (matchLength == RUN_MASK && !readLength(source, sourceSize, ip, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > destinationSize - op) {
+            return false;
+        }
+        // Matches may overlap their own output, so copy forward byte by byte
+        for (size_t i = 0; i < matchLength; ++i) {
+            destination[op + i] = destination[op - offset + i];
+        }
+        op += matchLength;
+    }
+    return false;
+}
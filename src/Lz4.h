@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// LZ4 block format (no frame header). The compressor is the plain greedy
+// single-pass variant, which is enough for an offline packer; the decoder is
+// what the runtime uses and checks every offset against both buffers.
+class Lz4 {
+public:
+    [[nodiscard]] static auto compress(const uint8_t* source, size_t sourceSize) -> std::vector<uint8_t>;
+    // Returns false unless the block decodes to exactly destinationSize bytes
+    [[nodiscard]] static auto decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize) -> bool;
+};
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <string>
+#include <span>
+#include "Settings.h"
 
 class Observer {
 public:
     virtual ~Observer() = default;
-    virtual void onSettingChanged(const std::string& settingName, float newValue) = 0;
-};
\ No newline at end of file
+    // Called at most once per tick with every setting that changed since the last batch
+    virtual void onSettingsChanged(std::span<const SettingDelta> changes) = 0;
+};
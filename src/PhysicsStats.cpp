@@ -0,0 +1,95 @@
+#include "PhysicsStats.h"
+#include <algorithm>
+
+namespace {
+
+const std::array<PhysicsMetric, 8> TIMING_METRICS = {{
+    {"step", [](const PhysicsSample& s) { return s.profile.step; }},
+    {"pairs", [](const PhysicsSample& s) { return s.profile.pairs; }},
+    {"collide", [](const PhysicsSample& s) { return s.profile.collide; }},
+    {"solve", [](const PhysicsSample& s) { return s.profile.solve; }},
+    {"solveConstraints", [](const PhysicsSample& s) { return s.profile.solveConstraints; }},
+    {"broadphase", [](const PhysicsSample& s) { return s.profile.broadphase; }},
+    {"continuous", [](const PhysicsSample& s) { return s.profile.continuous; }},
+    {"sleepIslands", [](const PhysicsSample& s) { return s.profile.sleepIslands; }},
+}};
+
+const std::array<PhysicsMetric, 7> COUNTER_METRICS = {{
+    {"bodies", [](const PhysicsSample& s) { return static_cast<float>(s.counters.bodyCount); }},
+    {"staticBodies", [](const PhysicsSample& s) { return static_cast<float>(s.counters.staticBodyCount); }},
+    {"shapes", [](const PhysicsSample& s) { return static_cast<float>(s.counters.shapeCount); }},
+    {"contacts", [](const PhysicsSample& s) { return static_cast<float>(s.counters.contactCount); }},
+    {"islands", [](const PhysicsSample& s) { return static_cast<float>(s.counters.islandCount); }},
+    {"staticTreeHeight", [](const PhysicsSample& s) { return static_cast<float>(s.counters.staticTreeHeight); }},
+    {"treeHeight", [](const PhysicsSample& s) { return static_cast<float>(s.counters.treeHeight); }},
+}};
+
+} // namespace
+
+auto PhysicsStats::getTimingMetrics() -> std::span<const PhysicsMetric> {
+    return TIMING_METRICS;
+}
+
+auto PhysicsStats::getCounterMetrics() -> std::span<const PhysicsMetric> {
+    return COUNTER_METRICS;
+}
+
+void PhysicsStats::record(b2WorldId worldId) {
+    newestSample = (newestSample + 1) % HISTORY_SIZE;
+    samples[newestSample] = PhysicsSample{b2World_GetProfile(worldId), b2World_GetCounters(worldId)};
+    sampleCount = std::min(sampleCount + 1, HISTORY_SIZE);
+    stepCount++;
+}
+
+void PhysicsStats::setSceneInfo(int newSubStepCount, size_t newChainVertexCount) {
+    subStepCount = newSubStepCount;
+    chainVertexCount = newChainVertexCount;
+}
+
+auto PhysicsStats::getSample(size_t age) const -> const PhysicsSample& {
+    return samples[(newestSample + HISTORY_SIZE - (age % HISTORY_SIZE)) % HISTORY_SIZE];
+}
+
+void PhysicsStats::copyHistory(const PhysicsMetric& metric, std::vector<float>& out) const {
+    out.resize(sampleCount);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        out[i] = metric.value(getSample(sampleCount - 1 - i));
+    }
+}
+
+auto PhysicsStats::average(const PhysicsMetric& metric) const -> float {
+    if (sampleCount == 0) {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (size_t age = 0; age < sampleCount; ++age) {
+        total += metric.value(getSample(age));
+    }
+    return total / static_cast<float>(sampleCount);
+}
+
+void PhysicsStats::writeCsvHeader(std::ostream& out) {
+    out << "step,subSteps,chainVertices";
+    for (const auto& metric : TIMING_METRICS) {
+        out << ',' << metric.name << "_ms";
+    }
+    for (const auto& metric : COUNTER_METRICS) {
+        out << ',' << metric.name;
+    }
+    out << '\n';
+}
+
+void PhysicsStats::writeCsvRow(std::ostream& out) const {
+    if (sampleCount == 0) {
+        return;
+    }
+    const PhysicsSample& sample = getSample(0);
+    out << (stepCount - 1) << ',' << subStepCount << ',' << chainVertexCount;
+    for (const auto& metric : TIMING_METRICS) {
+        out << ',' << metric.value(sample);
+    }
+    for (const auto& metric : COUNTER_METRICS) {
+        out << ',' << metric.value(sample);
+    }
+    out << '\n';
+}
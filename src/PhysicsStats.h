@@ -0,0 +1,59 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+struct PhysicsSample {
+    b2Profile profile;
+    b2Counters counters;
+};
+
+struct PhysicsMetric {
+    const char* name;
+    float (*value)(const PhysicsSample& sample);
+};
+
+// History of b2World_GetProfile / b2World_GetCounters, one sample per
+// b2World_Step, together with the scene parameters that drive solver cost.
+class PhysicsStats {
+public:
+    static constexpr size_t HISTORY_SIZE = 240;
+
+    // Step timings in milliseconds
+    static auto getTimingMetrics() -> std::span<const PhysicsMetric>;
+    // World counts (bodies, shapes, contacts, islands, tree heights)
+    static auto getCounterMetrics() -> std::span<const PhysicsMetric>;
+
+    // Call right after b2World_Step
+    void record(b2WorldId worldId);
+
+    void setSceneInfo(int subStepCount, size_t chainVertexCount);
+    [[nodiscard]] auto getSubStepCount() const -> int { return subStepCount; }
+    [[nodiscard]] auto getChainVertexCount() const -> size_t { return chainVertexCount; }
+
+    [[nodiscard]] auto getSampleCount() const -> size_t { return sampleCount; }
+    [[nodiscard]] auto getStepCount() const -> uint64_t { return stepCount; }
+    // age 0 is the most recent step
+    [[nodiscard]] auto getSample(size_t age) const -> const PhysicsSample&;
+
+    // Oldest-first values of one metric, for ImGui::PlotLines
+    void copyHistory(const PhysicsMetric& metric, std::vector<float>& out) const;
+    [[nodiscard]] auto average(const PhysicsMetric& metric) const -> float;
+
+    // CSV with one row per recorded step, for headless runs
+    static void writeCsvHeader(std::ostream& out);
+    void writeCsvRow(std::ostream& out) const;
+
+private:
+    std::array<PhysicsSample, HISTORY_SIZE> samples{};
+    size_t sampleCount = 0;
+    size_t newestSample = HISTORY_SIZE - 1;
+    uint64_t stepCount = 0;
+    int subStepCount = 0;
+    size_t chainVertexCount = 0;
+};
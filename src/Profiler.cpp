@@ -0,0 +1,213 @@
+#include "Profiler.h"
+#include "AllocationTracker.h"
+
+#ifdef PLATFORMER_PROFILER_ENABLED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_USE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_USE_TSC 1
+#endif
+
+namespace {
+
+// Single-producer (owning thread) / single-consumer (frame mark) ring of zones
+struct ThreadBuffer {
+    std::array<ProfileZone, Profiler::THREAD_BUFFER_CAPACITY> zones;
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    uint32_t threadIndex = 0;
+    bool inUse = false; // Guarded by the registry mutex
+};
+
+static_assert((Profiler::THREAD_BUFFER_CAPACITY & (Profiler::THREAD_BUFFER_CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+auto steadyNanoseconds() -> uint64_t {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct ProfilerState {
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    std::array<ProfileFrame, Profiler::HISTORY_SIZE> frames;
+    size_t frameCount = 0;
+    size_t newestFrame = 0;
+    uint64_t frameIndex = 0;
+    uint64_t frameStart = Profiler::now();
+
+    std::atomic<uint64_t> droppedZones{0};
+
+    uint64_t calibrationTicks = Profiler::now();
+    uint64_t calibrationNanoseconds = steadyNanoseconds();
+    double ticksPerMillisecond = 1e6;
+};
+
+auto state() -> ProfilerState& {
+    static ProfilerState instance;
+    return instance;
+}
+
+// Hands the thread's buffer back to the registry when the thread exits so short-lived workers reuse it
+struct ThreadBufferLease {
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadBufferLease() {
+        if (buffer != nullptr) {
+            std::lock_guard<std::mutex> lock(state().registryMutex);
+            buffer->inUse = false;
+        }
+    }
+};
+
+thread_local ThreadBufferLease threadBuffer;
+thread_local uint16_t threadDepth = 0;
+
+auto acquireThreadBuffer() -> ThreadBuffer* {
+    if (threadBuffer.buffer == nullptr) {
+        ProfilerState& s = state();
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        for (auto& buffer : s.threadBuffers) {
+            if (!buffer->inUse) {
+                threadBuffer.buffer = buffer.get();
+                break;
+            }
+        }
+        if (threadBuffer.buffer == nullptr) {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadIndex = static_cast<uint32_t>(s.threadBuffers.size());
+            threadBuffer.buffer = buffer.get();
+            s.threadBuffers.push_back(std::move(buffer));
+        }
+        threadBuffer.buffer->inUse = true;
+    }
+    return threadBuffer.buffer;
+}
+
+} // namespace
+
+auto Profiler::now() -> uint64_t {
+#ifdef PROFILER_USE_TSC
+    return __rdtsc();
+#else
+    return steadyNanoseconds();
+#endif
+}
+
+auto Profiler::ticksToMilliseconds(uint64_t ticks) -> double {
+    return static_cast<double>(ticks) / state().ticksPerMillisecond;
+}
+
+auto Profiler::getTicksPerMillisecond() -> double {
+    return state().ticksPerMillisecond;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end, uint16_t depth, uint32_t allocations) {
+    ThreadBuffer* buffer = acquireThreadBuffer();
+    uint32_t head = buffer->head.load(std::memory_order_relaxed);
+    uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= THREAD_BUFFER_CAPACITY) {
+        state().droppedZones.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->zones[head & (THREAD_BUFFER_CAPACITY - 1)] = ProfileZone{name, start, end, buffer->threadIndex, depth, allocations};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::endFrame() {
+    ProfilerState& s = state();
+    uint64_t frameEnd = now();
+
+#ifdef PROFILER_USE_TSC
+    uint64_t elapsedNanoseconds = steadyNanoseconds() - s.calibrationNanoseconds;
+    if (elapsedNanoseconds > 0) {
+        s.ticksPerMillisecond = static_cast<double>(frameEnd - s.calibrationTicks) * 1e6 / static_cast<double>(elapsedNanoseconds);
+    }
+#endif
+
+    s.newestFrame = (s.newestFrame + 1) % HISTORY_SIZE;
+    s.frameCount = std::min(s.frameCount + 1, HISTORY_SIZE);
+    ProfileFrame& frame = s.frames[s.newestFrame];
+    frame.index = s.frameIndex++;
+    frame.start = s.frameStart;
+    frame.end = frameEnd;
+    frame.zones.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        for (auto& buffer : s.threadBuffers) {
+            uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+            uint32_t head = buffer->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                frame.zones.push_back(buffer->zones[tail & (THREAD_BUFFER_CAPACITY - 1)]);
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    // Zones are recorded on scope exit, so restore start order for the timeline
+    std::sort(frame.zones.begin(), frame.zones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+        return a.start < b.start;
+    });
+
+    s.frameStart = frameEnd;
+}
+
+auto Profiler::getFrameCount() -> size_t {
+    return state().frameCount;
+}
+
+auto Profiler::getFrame(size_t age) -> const ProfileFrame& {
+    ProfilerState& s = state();
+    return s.frames[(s.newestFrame + HISTORY_SIZE - (age % HISTORY_SIZE)) % HISTORY_SIZE];
+}
+
+auto Profiler::getZoneStats() -> std::vector<ProfileZoneStats> {
+    std::vector<ProfileZoneStats> stats;
+    const size_t frameCount = getFrameCount();
+    for (size_t age = 0; age < frameCount; ++age) {
+        const ProfileFrame& frame = getFrame(age);
+        for (const auto& zone : frame.zones) {
+            auto it = std::find_if(stats.begin(), stats.end(), [&](const ProfileZoneStats& entry) { return entry.name == zone.name; });
+            if (it == stats.end()) {
+                stats.push_back({zone.name, 0.0, 0.0, 0, 0.0});
+                it = stats.end() - 1;
+            }
+            double ms = ticksToMilliseconds(zone.end - zone.start);
+            it->averageMs += ms;
+            it->maxMs = std::max(it->maxMs, ms);
+            it->calls++;
+            it->allocationsPerFrame += zone.allocations;
+        }
+    }
+    for (auto& entry : stats) {
+        entry.averageMs /= static_cast<double>(std::max<size_t>(frameCount, 1));
+        entry.allocationsPerFrame /= static_cast<double>(std::max<size_t>(frameCount, 1));
+    }
+    return stats;
+}
+
+auto Profiler::getDroppedZoneCount() -> uint64_t {
+    return state().droppedZones.load(std::memory_order_relaxed);
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : name(name), start(Profiler::now()), allocationsAtStart(AllocationTracker::getThreadTotals().allocations), depth(threadDepth++) {}
+
+ProfileScope::~ProfileScope() {
+    uint64_t end = Profiler::now();
+    auto allocations = static_cast<uint32_t>(AllocationTracker::getThreadTotals().allocations - allocationsAtStart);
+    --threadDepth;
+    Profiler::record(name, start, end, depth, allocations);
+}
+
+#endif
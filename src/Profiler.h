@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lightweight frame profiler. PROFILE_ZONE("name") records the enclosing scope
+// into a lock-free per-thread ring buffer; PROFILE_FRAME_MARK() closes the frame
+// and moves the recorded zones into a fixed history for the developer menu.
+// Release builds (NDEBUG) compile both macros to nothing unless
+// PLATFORMER_FORCE_PROFILER is defined.
+
+#if !defined(NDEBUG) || defined(PLATFORMER_FORCE_PROFILER)
+#define PLATFORMER_PROFILER_ENABLED 1
+#endif
+
+#ifdef PLATFORMER_PROFILER_ENABLED
+
+struct ProfileZone {
+    const char* name; // Must be a string literal or otherwise outlive the profiler
+    uint64_t start;
+    uint64_t end;
+    uint32_t threadIndex;
+    uint16_t depth;
+    uint32_t allocations; // Heap allocations inside the zone, 0 unless AllocationTracker is enabled
+};
+
+struct ProfileFrame {
+    uint64_t index = 0;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    std::vector<ProfileZone> zones;
+};
+
+struct ProfileZoneStats {
+    const char* name;
+    double averageMs; // Average time per frame over the history
+    double maxMs;     // Longest single call over the history
+    uint32_t calls;
+    double allocationsPerFrame;
+};
+
+class Profiler {
+public:
+    static constexpr size_t HISTORY_SIZE = 240;
+    static constexpr size_t THREAD_BUFFER_CAPACITY = 4096;
+
+    // Raw timestamp: TSC ticks on x86, steady_clock nanoseconds elsewhere
+    static auto now() -> uint64_t;
+    static auto ticksToMilliseconds(uint64_t ticks) -> double;
+    [[nodiscard]] static auto getTicksPerMillisecond() -> double;
+
+    static void record(const char* name, uint64_t start, uint64_t end, uint16_t depth, uint32_t allocations);
+    static void endFrame();
+
+    // age 0 is the most recently completed frame
+    [[nodiscard]] static auto getFrameCount() -> size_t;
+    [[nodiscard]] static auto getFrame(size_t age) -> const ProfileFrame&;
+    [[nodiscard]] static auto getZoneStats() -> std::vector<ProfileZoneStats>;
+    [[nodiscard]] static auto getDroppedZoneCount() -> uint64_t;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    auto operator=(const ProfileScope&) -> ProfileScope& = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+    uint64_t allocationsAtStart;
+    uint16_t depth;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME_MARK() Profiler::endFrame()
+
+#else
+
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME_MARK() ((void)0)
+
+#endif
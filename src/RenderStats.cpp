@@ -0,0 +1,26 @@
+#include "RenderStats.h"
+
+RenderCounters RenderStats::counters;
+SDL_Texture* RenderStats::lastTexture = nullptr;
+bool RenderStats::hasLastDraw = false;
+
+void RenderStats::recordDraw(SDL_Texture* texture, int vertexCount) {
+    // Untextured draws also break a texture batch, so nullptr counts as a texture here
+    if (!hasLastDraw || texture != lastTexture) {
+        counters.textureSwitches++;
+    }
+    lastTexture = texture;
+    hasLastDraw = true;
+    counters.drawCalls++;
+    counters.vertices += static_cast<uint64_t>(vertexCount);
+}
+
+void RenderStats::reset() {
+    counters = RenderCounters{};
+    lastTexture = nullptr;
+    hasLastDraw = false;
+}
+
+auto RenderStats::getCounters() -> const RenderCounters& {
+    return counters;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+
+struct RenderCounters {
+    uint64_t drawCalls = 0;
+    uint64_t textureSwitches = 0;
+    uint64_t vertices = 0;
+};
+
+// Counts what the game submits to SDL_Renderer. Every SDL_Render* call site
+// reports here so draw calls, texture switches and vertices can be compared
+// between changes without a GPU profiler.
+class RenderStats {
+public:
+    static void recordDraw(SDL_Texture* texture, int vertexCount);
+    static void reset();
+    [[nodiscard]] static auto getCounters() -> const RenderCounters&;
+
+private:
+    static RenderCounters counters;
+    static SDL_Texture* lastTexture;
+    static bool hasLastDraw;
+};
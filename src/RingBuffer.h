@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Fixed-capacity FIFO over inline storage. Pushing into a full buffer
+// overwrites the oldest element, so it never allocates after construction.
+// Index 0 and begin() are the oldest element. Capacity must be a power of two
+// so wrapping is a mask instead of a division.
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+    static constexpr size_t MASK = Capacity - 1;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using Buffer = std::conditional_t<Const, const RingBuffer, RingBuffer>;
+
+        Iterator() = default;
+        Iterator(Buffer* buffer, size_t index) : buffer(buffer), index(index) {}
+
+        auto operator*() const -> reference { return (*buffer)[index]; }
+        auto operator->() const -> pointer { return &(*buffer)[index]; }
+        auto operator++() -> Iterator& { ++index; return *this; }
+        auto operator++(int) -> Iterator { Iterator previous = *this; ++index; return previous; }
+        auto operator==(const Iterator& other) const -> bool { return index == other.index; }
+
+    private:
+        Buffer* buffer = nullptr;
+        size_t index = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    [[nodiscard]] static constexpr auto capacity() -> size_t { return Capacity; }
+    [[nodiscard]] auto size() const -> size_t { return count; }
+    [[nodiscard]] auto empty() const -> bool { return count == 0; }
+    [[nodiscard]] auto full() const -> bool { return count == Capacity; }
+
+    void push(const T& value) {
+        items[(head + count) & MASK] = value;
+        if (count == Capacity) {
+            head = (head + 1) & MASK;
+        } else {
+            count++;
+        }
+    }
+
+    // Makes room for one more element, dropping the oldest if full, and returns it
+    // unassigned, so elements that own storage can be refilled without reallocating
+    auto pushSlot() -> T& {
+        if (count == Capacity) {
+            head = (head + 1) & MASK;
+        } else {
+            count++;
+        }
+        return back();
+    }
+
+    // Precondition: !empty()
+    void popFront() {
+        head = (head + 1) & MASK;
+        count--;
+    }
+
+    // Drops the oldest elements until at most maxSize remain
+    void truncateFront(size_t maxSize) {
+        if (count > maxSize) {
+            head = (head + (count - maxSize)) & MASK;
+            count = maxSize;
+        }
+    }
+
+    // Drops the newest elements until at most maxSize remain
+    void truncateBack(size_t maxSize) {
+        count = count > maxSize ? maxSize : count;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    auto operator[](size_t index) -> T& { return items[(head + index) & MASK]; }
+    auto operator[](size_t index) const -> const T& { return items[(head + index) & MASK]; }
+    auto front() -> T& { return (*this)[0]; }
+    auto front() const -> const T& { return (*this)[0]; }
+    auto back() -> T& { return (*this)[count - 1]; }
+    auto back() const -> const T& { return (*this)[count - 1]; }
+
+    auto begin() -> iterator { return {this, 0}; }
+    auto end() -> iterator { return {this, count}; }
+    auto begin() const -> const_iterator { return {this, 0}; }
+    auto end() const -> const_iterator { return {this, count}; }
+
+private:
+    std::array<T, Capacity> items{};
+    size_t head = 0;
+    size_t count = 0;
+};
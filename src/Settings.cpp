@@ -0,0 +1,63 @@
+#include "Settings.h"
+#include <algorithm>
+
+namespace {
+
+auto clampToRange(const SettingInfo& info, SettingValue value) -> SettingValue {
+    const float low = std::min(info.sliderStart, info.sliderEnd);
+    const float high = std::max(info.sliderStart, info.sliderEnd);
+    if (auto* number = std::get_if<float>(&value)) {
+        *number = std::clamp(*number, low, high);
+    } else if (auto* integer = std::get_if<int>(&value)) {
+        *integer = std::clamp(*integer, static_cast<int>(low), static_cast<int>(high));
+    }
+    return value;
+}
+
+} // namespace
+
+SettingsRegistry::SettingsRegistry() {
+    for (const SettingInfo& info : SETTING_INFO) {
+        values[static_cast<size_t>(info.id)] = info.defaultValue;
+    }
+    batch.reserve(SETTING_COUNT);
+}
+
+void SettingsRegistry::set(SettingId id, SettingValue value) {
+    const size_t index = static_cast<size_t>(id);
+    if (value.index() != values[index].index()) {
+        return;
+    }
+    value = clampToRange(getInfo(id), value);
+    if (value != values[index]) {
+        values[index] = value;
+        changed.set(index);
+    }
+}
+
+void SettingsRegistry::markAllChanged() {
+    changed.set();
+}
+
+void SettingsRegistry::apply(std::span<const SettingDelta> values) {
+    for (const SettingDelta& delta : values) {
+        set(delta.id, delta.value);
+    }
+}
+
+void SettingsRegistry::save(nlohmann::json& json) const {
+    for (const SettingInfo& info : SETTING_INFO) {
+        std::visit([&](auto value) { json[info.key] = value; }, values[static_cast<size_t>(info.id)]);
+    }
+}
+
+auto SettingsRegistry::takeChanges() -> std::span<const SettingDelta> {
+    batch.clear();
+    for (size_t i = 0; i < SETTING_COUNT; ++i) {
+        if (changed.test(i)) {
+            batch.push_back(SettingDelta{static_cast<SettingId>(i), values[i]});
+        }
+    }
+    changed.reset();
+    return batch;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <span>
+#include <variant>
+#include <vector>
+
+enum class SettingSection {
+    Tuning,
+    Box2DDebugDraw // Only shown while enableBox2DDebugDraw is on
+};
+
+// Every developer setting, declared once:
+// X(id, JSON key, label, type, default, slider start, slider end, section)
+// Slider ends may be reversed (gravity runs from 0 down to -30); loaded values are clamped to the range.
+#define PLATFORMER_SETTINGS(X)                                                                                          \
+    X(Gravity, "gravity", "Gravity", float, -9.8f, 0.0f, -30.0f, Tuning)                                                \
+    X(CharacterSpeed, "characterSpeed", "Character Speed", float, 5.0f, 0.0f, 20.0f, Tuning)                            \
+    X(JumpStrength, "jumpStrength", "Jump Strength", float, 10.0f, 0.0f, 50.0f, Tuning)                                 \
+    X(MinJumpHeight, "minJumpHeight", "Minimum Jump Height", float, 1.0f, 0.0f, 10.0f, Tuning)                          \
+    X(MaxJumpHeight, "maxJumpHeight", "Maximum Jump Height", float, 5.0f, 0.0f, 20.0f, Tuning)                          \
+    X(JumpCooldownDuration, "jumpCooldownDuration", "Jump Cooldown Duration", float, 0.5f, 0.0f, 5.0f, Tuning)          \
+    X(GroundAcceleration, "groundAcceleration", "Ground Acceleration", float, 10.0f, 0.0f, 20.0f, Tuning)               \
+    X(AirAcceleration, "airAcceleration", "Air Acceleration", float, 5.0f, 0.0f, 20.0f, Tuning)                         \
+    X(MaxWalkingSpeed, "maxWalkingSpeed", "Max Walking Speed", float, 7.0f, 0.0f, 20.0f, Tuning)                        \
+    X(ShowDebugVisualizations, "showDebugVisualizations", "Show Debug Visualizations", bool, false, 0, 1, Tuning)       \
+    X(ShowContactPoints, "showContactPoints", "Show Contact Points", bool, false, 0, 1, Tuning)                         \
+    X(ShowForceVisualizations, "showForceVisualizations", "Show Force Visualizations", bool, false, 0, 1, Tuning)       \
+    X(MaxContactPoints, "maxContactPoints", "Max Contact Points", int, 10, 1, 100, Tuning)                              \
+    X(EnableBox2DDebugDraw, "enableBox2DDebugDraw", "Enable Box2D Debug Draw", bool, false, 0, 1, Tuning)               \
+    X(DrawShapes, "drawShapes", "Draw Shapes", bool, true, 0, 1, Box2DDebugDraw)                                        \
+    X(DrawJoints, "drawJoints", "Draw Joints", bool, true, 0, 1, Box2DDebugDraw)                                        \
+    X(DrawAABBs, "drawAABBs", "Draw AABBs", bool, false, 0, 1, Box2DDebugDraw)                                          \
+    X(DrawContactPoints, "drawContactPoints", "Draw Contact Points", bool, false, 0, 1, Box2DDebugDraw)                 \
+    X(DrawContactNormals, "drawContactNormals", "Draw Contact Normals", bool, false, 0, 1, Box2DDebugDraw)              \
+    X(DrawContactImpulses, "drawContactImpulses", "Draw Contact Impulses", bool, false, 0, 1, Box2DDebugDraw)           \
+    X(DrawFrictionImpulses, "drawFrictionImpulses", "Draw Friction Impulses", bool, false, 0, 1, Box2DDebugDraw)
+
+enum class SettingId : size_t {
+#define PLATFORMER_SETTING_ID(id, key, label, type, defaultValue, start, end, section) id,
+    PLATFORMER_SETTINGS(PLATFORMER_SETTING_ID)
+#undef PLATFORMER_SETTING_ID
+    Count
+};
+
+constexpr size_t SETTING_COUNT = static_cast<size_t>(SettingId::Count);
+
+using SettingValue = std::variant<bool, int, float>;
+
+struct SettingInfo {
+    SettingId id;
+    const char* key;
+    const char* label;
+    SettingValue defaultValue;
+    float sliderStart;
+    float sliderEnd;
+    SettingSection section;
+};
+
+inline constexpr std::array<SettingInfo, SETTING_COUNT> SETTING_INFO = {{
+#define PLATFORMER_SETTING_INFO(id, key, label, type, defaultValue, start, end, section) \
+    {SettingId::id, key, label, SettingValue(std::in_place_type<type>, defaultValue), start, end, SettingSection::section},
+    PLATFORMER_SETTINGS(PLATFORMER_SETTING_INFO)
+#undef PLATFORMER_SETTING_INFO
+}};
+
+// Compile-time type of each setting, for get<Id>()
+template <SettingId Id>
+struct SettingTraits;
+#define PLATFORMER_SETTING_TRAITS(id, key, label, type, defaultValue, start, end, section) \
+    template <>                                                                           \
+    struct SettingTraits<SettingId::id> {                                                 \
+        using Type = type;                                                                \
+    };
+PLATFORMER_SETTINGS(PLATFORMER_SETTING_TRAITS)
+#undef PLATFORMER_SETTING_TRAITS
+
+struct SettingDelta {
+    SettingId id;
+    SettingValue value;
+
+    template <typename T>
+    [[nodiscard]] auto get() const -> T { return std::get<T>(value); }
+};
+
+// Current value of every setting. Changes are coalesced per setting and
+// handed out as one batch of typed deltas by takeChanges().
+class SettingsRegistry {
+public:
+    SettingsRegistry();
+
+    template <SettingId Id>
+    [[nodiscard]] auto get() const -> typename SettingTraits<Id>::Type {
+        return std::get<typename SettingTraits<Id>::Type>(values[static_cast<size_t>(Id)]);
+    }
+    [[nodiscard]] auto getValue(SettingId id) const -> const SettingValue& { return values[static_cast<size_t>(id)]; }
+    [[nodiscard]] static auto getInfo(SettingId id) -> const SettingInfo& { return SETTING_INFO[static_cast<size_t>(id)]; }
+
+    // Stores the value (clamped to the setting's range) and queues a delta if it changed
+    void set(SettingId id, SettingValue value);
+    // Queues every setting, e.g. to push the loaded state to a new observer
+    void markAllChanged();
+
+    // Sets each value in order, e.g. the developer settings from GameConfig
+    void apply(std::span<const SettingDelta> values);
+    void save(nlohmann::json& json) const;
+
+    // Pending deltas in SettingId order; the span is valid until the next call
+    auto takeChanges() -> std::span<const SettingDelta>;
+
+private:
+    std::array<SettingValue, SETTING_COUNT> values;
+    std::bitset<SETTING_COUNT> changed;
+    std::vector<SettingDelta> batch;
+};
@@ -0,0 +1,74 @@
+#include "StepGovernor.h"
+#include "Logging.h"
+#include <algorithm>
+
+StepGovernor::StepGovernor(const StepGovernorConfig& config, float frameBudgetMs)
+    : config(config), frameBudgetMs(frameBudgetMs), subStepCount(config.maxSubSteps), averageFrameMs(frameBudgetMs) {}
+
+void StepGovernor::setConfig(const StepGovernorConfig& newConfig) {
+    config = newConfig;
+    subStepCount = config.enabled ? std::clamp(subStepCount, config.minSubSteps, config.maxSubSteps) : config.maxSubSteps;
+    if (!config.enabled) {
+        detailLevel = DetailLevel::Full;
+    }
+}
+
+void StepGovernor::update(float stepMs, float frameMs) {
+    frameIndex++;
+    decision = nullptr;
+    averageStepMs += (stepMs - averageStepMs) * SMOOTHING;
+    averageFrameMs += (frameMs - averageFrameMs) * SMOOTHING;
+    if (!config.enabled) {
+        return;
+    }
+
+    // Step cost is close to proportional to the sub-step count
+    framesSinceSubStepChange++;
+    if (framesSinceSubStepChange >= ADJUST_INTERVAL) {
+        const float perSubStepMs = averageStepMs / static_cast<float>(subStepCount);
+        if (averageStepMs > config.stepBudgetMs && subStepCount > config.minSubSteps) {
+            subStepCount--;
+            averageStepMs -= perSubStepMs;
+            framesSinceSubStepChange = 0;
+            decide("lowered sub-steps");
+        } else if (subStepCount < config.maxSubSteps && perSubStepMs * static_cast<float>(subStepCount + 1) < config.stepBudgetMs * RAISE_HEADROOM) {
+            subStepCount++;
+            averageStepMs += perSubStepMs;
+            framesSinceSubStepChange = 0;
+            decide("raised sub-steps");
+        }
+    }
+
+    framesSinceDetailChange++;
+    onTimeFrames = frameMs <= frameBudgetMs * FRAME_ON_TIME_FACTOR ? onTimeFrames + 1 : 0;
+    if (averageFrameMs > frameBudgetMs * FRAME_OVERRUN_FACTOR && detailLevel != DetailLevel::Minimal && framesSinceDetailChange >= ADJUST_INTERVAL) {
+        detailLevel = static_cast<DetailLevel>(static_cast<int>(detailLevel) + 1);
+        framesSinceDetailChange = 0;
+        decide("reduced detail");
+    } else if (onTimeFrames >= RECOVERY_FRAMES && detailLevel != DetailLevel::Full) {
+        detailLevel = static_cast<DetailLevel>(static_cast<int>(detailLevel) - 1);
+        onTimeFrames = 0;
+        framesSinceDetailChange = 0;
+        decide("restored detail");
+    }
+}
+
+void StepGovernor::decide(const char* what) {
+    decision = what;
+    lastDecision = what;
+    lastDecisionFrame = frameIndex;
+    getLogger(LogSubsystem::Physics)->debug("Step governor {}: {} sub-steps, detail {}, step {:.2f} ms, frame {:.2f} ms", what, subStepCount,
+                                            toString(detailLevel), averageStepMs, averageFrameMs);
+}
+
+auto StepGovernor::toString(DetailLevel level) -> const char* {
+    switch (level) {
+        case DetailLevel::Full:
+            return "full";
+        case DetailLevel::Reduced:
+            return "reduced";
+        case DetailLevel::Minimal:
+            return "minimal";
+    }
+    return "unknown";
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include "GameConfig.h"
+
+// Optional work the game drops, in order, when frames miss their budget
+enum class DetailLevel : uint8_t {
+    Full,
+    Reduced, // Box2D debug draw shows shapes only: no contacts, impulses, AABBs or joints
+    Minimal, // No Box2D debug draw at all
+};
+
+// Picks the Box2D sub-step count from the measured cost of b2World_Step
+// (b2Profile::step), within StepGovernorConfig's bounds. A smoothed step cost
+// above the budget drops one sub-step; raising one needs the cost predicted
+// for the extra sub-step to stay comfortably under budget. Independently, a
+// smoothed frame time over the frame budget lowers the DetailLevel, and a
+// long run of on-time frames raises it again. Changes are spaced out so one
+// slow frame cannot make it oscillate.
+class StepGovernor {
+public:
+    static constexpr float SMOOTHING = 0.1f;               // Weight of the newest sample in the averages
+    static constexpr int ADJUST_INTERVAL = 30;             // Frames between sub-step changes
+    static constexpr int RECOVERY_FRAMES = 120;            // On-time frames before detail is restored
+    static constexpr float RAISE_HEADROOM = 0.8f;          // Predicted cost must fit in this much of the budget
+    static constexpr float FRAME_OVERRUN_FACTOR = 1.2f;    // Smoothed frame time that counts as over budget
+    static constexpr float FRAME_ON_TIME_FACTOR = 1.05f;   // Frame time that counts as on time (vsync jitter)
+
+    StepGovernor(const StepGovernorConfig& config, float frameBudgetMs);
+
+    // Clamps the current sub-step count into the new bounds; disabled pins it at maxSubSteps
+    void setConfig(const StepGovernorConfig& config);
+    // Call once per frame with the last step's b2Profile::step and the frame's total time
+    void update(float stepMs, float frameMs);
+
+    [[nodiscard]] auto getSubStepCount() const -> int { return subStepCount; }
+    [[nodiscard]] auto getDetailLevel() const -> DetailLevel { return detailLevel; }
+    [[nodiscard]] auto getAverageStepMs() const -> float { return averageStepMs; }
+    [[nodiscard]] auto getAverageFrameMs() const -> float { return averageFrameMs; }
+    [[nodiscard]] auto getConfig() const -> const StepGovernorConfig& { return config; }
+    // What the last update changed, or nullptr if nothing; a string literal
+    [[nodiscard]] auto getDecision() const -> const char* { return decision; }
+    // The most recent change and the update it happened in, for the developer menu
+    [[nodiscard]] auto getLastDecision() const -> const char* { return lastDecision; }
+    [[nodiscard]] auto getLastDecisionFrame() const -> uint64_t { return lastDecisionFrame; }
+
+    static auto toString(DetailLevel level) -> const char*;
+
+private:
+    void decide(const char* what);
+
+    StepGovernorConfig config;
+    float frameBudgetMs;
+    int subStepCount;
+    DetailLevel detailLevel = DetailLevel::Full;
+    float averageStepMs = 0.0f;
+    float averageFrameMs = 0.0f;
+    int framesSinceSubStepChange = 0;
+    int framesSinceDetailChange = 0;
+    int onTimeFrames = 0;
+    uint64_t frameIndex = 0;
+    const char* decision = nullptr;
+    const char* lastDecision = "none";
+    uint64_t lastDecisionFrame = 0;
+};
@@ -1,37 +1,24 @@
 #include "Tile.h"
 #include "Utils.h"
-#include <SDL3_image/SDL_image.h>
+#include "RenderStats.h"
 #include <iostream>
 #include <spdlog/spdlog.h>
 
-Tile::Tile(SDL_Renderer* renderer, const std::string& type, b2BodyId bodyId, b2ChainId chainId, b2ShapeId shapeId, uint32_t width, uint32_t height, const std::string& assetDir, int x, int y)
-    : renderer(renderer), bodyId(bodyId), chainId(chainId), shapeId(shapeId), width(width), height(height), type(type), x(x), y(y), showForceVectors(false) {
-    std::string texturePath = assetDir + "/tiles/" + type + ".png";
-    SDL_Surface* surface = IMG_Load(texturePath.c_str());
-    if (surface == nullptr) {
-        std::cerr << "Failed to load texture: " << texturePath << " Error: " << SDL_GetError() << std::endl;
-        return;
-    }
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-    if (texture == nullptr) {
-        std::cerr << "Failed to create texture from surface: " << SDL_GetError() << std::endl;
-    }
+Tile::Tile(SDL_Renderer* renderer, const std::string& type, b2BodyId bodyId, b2ChainId chainId, b2ShapeId shapeId, uint32_t width, uint32_t height, SDL_Texture* texture, int x, int y)
+    : renderer(renderer), bodyId(bodyId), chainId(chainId), shapeId(shapeId), width(width), height(height), texture(texture), type(type), x(x), y(y), showForceVectors(false) {
 }
 
 Tile::~Tile() {
-    // Chain shapes are managed by the Level class, so we don't destroy them here
-    if (texture != nullptr) {
-        SDL_DestroyTexture(texture);
-    }
+    // Chain shapes are managed by the Level class and textures by the AssetCache, so we don't destroy them here
 }
 
 void Tile::update() {
 }
 
-void Tile::render(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight) {
+void Tile::render(const CameraTransform& camera) {
+    const float scale = camera.getScale();
     b2Vec2 position = {static_cast<float>(x), static_cast<float>(y)};
-    SDL_FPoint screenPos = Box2DToSDL(position, scale, offsetX, offsetY, windowWidth, windowHeight);
+    SDL_FPoint screenPos = camera.toScreen(position);
 
     SDL_FRect dstRect;
     dstRect.x = static_cast<int>(screenPos.x);
@@ -43,6 +30,7 @@ void Tile::render(float scale, float offsetX, float offsetY, uint32_t windowWidt
     //             type, position.x, position.y, screenPos.x, screenPos.y);
 
     SDL_RenderTexture(renderer, texture, nullptr, &dstRect);
+    RenderStats::recordDraw(texture, 4);
 
     if (showForceVectors) {
         b2Vec2 velocity = b2Body_GetLinearVelocity(bodyId); // Assuming you want to get the linear velocity instead of force
@@ -52,10 +40,11 @@ void Tile::render(float scale, float offsetX, float offsetY, uint32_t windowWidt
         };
         SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255); // Blue for gravity
         SDL_RenderLine(renderer, screenPos.x, screenPos.y, forceEndPos.x, forceEndPos.y);
+        RenderStats::recordDraw(nullptr, 2);
     }
 }
 
-void Tile::renderPolygonOutline(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight) {
+void Tile::renderPolygonOutline(const CameraTransform& camera) {
     if (chainId == b2_nullChainId) return;
 
     b2Polygon polygon = b2Shape_GetPolygon(shapeId);
@@ -66,10 +55,11 @@ void Tile::renderPolygonOutline(float scale, float offsetX, float offsetY, uint3
         b2Vec2 p1 = polygon.vertices[i];
         b2Vec2 p2 = polygon.vertices[(i + 1) % polygon.count];
 
-        SDL_FPoint screenP1 = Box2DToSDL(p1, scale, offsetX, offsetY, windowWidth, windowHeight);
-        SDL_FPoint screenP2 = Box2DToSDL(p2, scale, offsetX, offsetY, windowWidth, windowHeight);
+        SDL_FPoint screenP1 = camera.toScreen(p1);
+        SDL_FPoint screenP2 = camera.toScreen(p2);
 
         SDL_RenderLine(renderer, screenP1.x, screenP1.y, screenP2.x, screenP2.y);
+        RenderStats::recordDraw(nullptr, 2);
     }
 }
 
@@ -97,6 +87,10 @@ auto Tile::getType() const -> const std::string& {
     return type;
 }
 
+auto Tile::getTexture() const -> SDL_Texture* {
+    return texture;
+}
+
 // Comparison operators for b2ChainId
 bool operator==(const b2ChainId& lhs, const b2ChainId& rhs) {
     return lhs.index1 == rhs.index1 && lhs.world0 == rhs.world0 && lhs.revision == rhs.revision;
@@ -4,17 +4,18 @@
 #include <box2d/box2d.h>
 #include <string>
 #include "Animation.h"
+#include "CameraTransform.h"
 
 class Tile {
 public:
     static const int TILE_SIZE = 32; // Assuming each tile is 32x32 pixels
 
-    Tile(SDL_Renderer* renderer, const std::string& type, b2BodyId bodyId, b2ChainId chainId, b2ShapeId shapeId, uint32_t width, uint32_t height, const std::string& assetDir, int x, int y);
+    Tile(SDL_Renderer* renderer, const std::string& type, b2BodyId bodyId, b2ChainId chainId, b2ShapeId shapeId, uint32_t width, uint32_t height, SDL_Texture* texture, int x, int y);
     ~Tile();
 
     void update();
-    void render(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight);
-    void renderPolygonOutline(float scale, float offsetX, float offsetY, uint32_t windowWidth, uint32_t windowHeight);
+    void render(const CameraTransform& camera);
+    void renderPolygonOutline(const CameraTransform& camera);
     void updateAnimation(float deltaTime);
 
     [[nodiscard]] auto getX() const -> int;
@@ -22,6 +23,7 @@ public:
     [[nodiscard]] auto getWidth() const -> uint32_t;
     [[nodiscard]] auto getHeight() const -> uint32_t;
     [[nodiscard]] auto getType() const -> const std::string&;
+    [[nodiscard]] auto getTexture() const -> SDL_Texture*;
 
 private:
     std::string type;
@@ -34,7 +36,7 @@ private:
     b2ShapeId shapeId;
 
     SDL_Renderer* renderer;
-    SDL_Texture* texture;
+    SDL_Texture* texture; // Owned by the AssetCache
     Animation animation;
 
     // Debug visualization member variables
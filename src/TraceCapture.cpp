@@ -0,0 +1,213 @@
+#include "TraceCapture.h"
+#include "Config.h"
+#include "Profiler.h"
+#include "StepGovernor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+constexpr size_t EXPECTED_ZONES_PER_FRAME = 32;
+
+// Synthetic tracks next to the profiler's per-thread tracks
+constexpr uint32_t FRAME_TRACK = 1000;
+constexpr uint32_t PHYSICS_TRACK = 1001;
+constexpr uint32_t GOVERNOR_TRACK = 1002;
+
+#ifndef PLATFORMER_PROFILER_ENABLED
+auto steadyNanoseconds() -> uint64_t {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+auto defaultTracePath() -> std::string {
+    std::time_t now = std::time(nullptr);
+    std::tm localTime{};
+#ifdef _WIN32
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), "trace_%Y%m%d_%H%M%S.json", &localTime);
+    return buffer;
+}
+
+} // namespace
+
+TraceCapture::~TraceCapture() {
+    if (isCapturing() && !capture.frames.empty()) {
+        spdlog::info("Writing partial trace capture of {} frames", capture.frames.size());
+        finish();
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void TraceCapture::start(int frameCount, const std::string& path) {
+    if (frameCount <= 0) {
+        return;
+    }
+    if (isCapturing()) {
+        spdlog::warn("Trace capture already running, {} frames remaining", remainingFrames);
+        return;
+    }
+
+    capture = Capture{};
+    capture.path = path.empty() ? defaultTracePath() : path;
+    capture.frames.reserve(frameCount);
+    capture.physics.reserve(frameCount);
+    capture.governor.reserve(frameCount);
+    capture.zones.reserve(frameCount * EXPECTED_ZONES_PER_FRAME);
+    remainingFrames = frameCount;
+#ifndef PLATFORMER_PROFILER_ENABLED
+    lastFrameEnd = steadyNanoseconds();
+#endif
+    spdlog::info("Capturing {} frames to {}", frameCount, capture.path);
+}
+
+void TraceCapture::captureFrame(const b2Profile& physicsProfile, const StepGovernor* governor) {
+    if (!isCapturing()) {
+        return;
+    }
+
+#ifdef PLATFORMER_PROFILER_ENABLED
+    const ProfileFrame& frame = Profiler::getFrame(0);
+    const uint64_t frameStart = frame.start;
+    const uint64_t frameEnd = frame.end;
+    uint64_t stepStart = frameStart;
+    for (const auto& zone : frame.zones) {
+        capture.zones.push_back({zone.name, zone.start, zone.end, zone.threadIndex});
+        if (std::strcmp(zone.name, "b2World_Step") == 0) {
+            stepStart = zone.start;
+        }
+    }
+    capture.ticksPerMillisecond = Profiler::getTicksPerMillisecond();
+#else
+    // Without the profiler only frame markers and Box2D timings are available
+    const uint64_t frameStart = lastFrameEnd;
+    const uint64_t frameEnd = steadyNanoseconds();
+    const uint64_t stepStart = frameStart;
+    lastFrameEnd = frameEnd;
+#endif
+
+    if (capture.frames.empty()) {
+        capture.origin = frameStart;
+#ifdef PLATFORMER_PROFILER_ENABLED
+        if (!frame.zones.empty()) {
+            capture.origin = std::min(capture.origin, frame.zones.front().start);
+        }
+#endif
+    }
+    capture.frames.push_back({"Frame", frameStart, frameEnd, FRAME_TRACK});
+    capture.physics.push_back({stepStart, physicsProfile});
+    if (governor != nullptr) {
+        capture.governor.push_back({frameEnd, governor->getSubStepCount(), static_cast<int>(governor->getDetailLevel()), governor->getDecision()});
+    }
+
+    if (--remainingFrames == 0) {
+        finish();
+    }
+}
+
+void TraceCapture::finish() {
+    remainingFrames = 0;
+    if (writer.joinable()) {
+        writer.join();
+    }
+    writer = std::thread([job = std::move(capture)]() { write(job); });
+    capture = Capture{};
+}
+
+void TraceCapture::write(const Capture& capture) {
+    std::ofstream out(capture.path);
+    if (!out.is_open()) {
+        spdlog::error("Failed to open trace file: {}", capture.path);
+        return;
+    }
+
+    const double microsecondsPerTick = 1000.0 / capture.ticksPerMillisecond;
+    auto toMicroseconds = [&](uint64_t ticks) {
+        return static_cast<double>(static_cast<int64_t>(ticks - capture.origin)) * microsecondsPerTick;
+    };
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":")" << PROJECT_NAME << "\"}}";
+
+    uint32_t maxThreadIndex = 0;
+    for (const auto& zone : capture.zones) {
+        maxThreadIndex = std::max(maxThreadIndex, zone.threadIndex);
+    }
+    for (uint32_t thread = 0; thread <= maxThreadIndex; ++thread) {
+        out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread
+            << R"(,"args":{"name":")" << (thread == 0 ? std::string("Main") : "Thread " + std::to_string(thread)) << "\"}}";
+    }
+    out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << FRAME_TRACK << R"(,"args":{"name":"Frames"}})";
+    out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << PHYSICS_TRACK << R"(,"args":{"name":"Box2D step"}})";
+    if (!capture.governor.empty()) {
+        out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << GOVERNOR_TRACK << R"(,"args":{"name":"Step governor"}})";
+    }
+
+    auto writeComplete = [&](const std::string& name, double start, double duration, uint32_t track) {
+        out << ",\n" << R"({"name":)" << nlohmann::json(name).dump() << R"(,"ph":"X","pid":1,"tid":)" << track
+            << R"(,"ts":)" << start << R"(,"dur":)" << duration << "}";
+    };
+
+    for (size_t i = 0; i < capture.frames.size(); ++i) {
+        const Event& frame = capture.frames[i];
+        double start = toMicroseconds(frame.start);
+        writeComplete("Frame " + std::to_string(i), start, toMicroseconds(frame.end) - start, frame.threadIndex);
+    }
+
+    for (const auto& zone : capture.zones) {
+        double start = toMicroseconds(zone.start);
+        writeComplete(zone.name, start, toMicroseconds(zone.end) - start, zone.threadIndex);
+    }
+
+    // b2Profile only has durations (ms), so the stages are laid out back to back from the start of the step
+    for (const auto& sample : capture.physics) {
+        const b2Profile& p = sample.profile;
+        double start = toMicroseconds(sample.timestamp);
+        writeComplete("step", start, p.step * 1000.0, PHYSICS_TRACK);
+        writeComplete("pairs", start, p.pairs * 1000.0, PHYSICS_TRACK);
+        writeComplete("collide", start + (p.pairs * 1000.0), p.collide * 1000.0, PHYSICS_TRACK);
+        writeComplete("solve", start + ((p.pairs + p.collide) * 1000.0), p.solve * 1000.0, PHYSICS_TRACK);
+
+        nlohmann::json args = {
+            {"buildIslands", p.buildIslands},
+            {"solveConstraints", p.solveConstraints},
+            {"broadphase", p.broadphase},
+            {"continuous", p.continuous},
+            {"sleepIslands", p.sleepIslands},
+        };
+        out << ",\n" << R"json({"name":"Box2D (ms)","ph":"C","pid":1,"ts":)json" << start << R"(,"args":)" << args.dump() << "}";
+    }
+
+    // Counters for the settings in force after each frame, and an instant event for every change
+    for (const auto& sample : capture.governor) {
+        const double timestamp = toMicroseconds(sample.timestamp);
+        out << ",\n" << R"({"name":"Step governor","ph":"C","pid":1,"ts":)" << timestamp << R"(,"args":{"subSteps":)" << sample.subStepCount
+            << R"(,"detailLevel":)" << sample.detailLevel << "}}";
+        if (sample.decision != nullptr) {
+            out << ",\n" << R"({"name":)" << nlohmann::json(sample.decision).dump() << R"(,"ph":"i","s":"t","pid":1,"tid":)" << GOVERNOR_TRACK
+                << R"(,"ts":)" << timestamp << "}";
+        }
+    }
+
+    out << "\n]}\n";
+    out.close();
+
+    if (out.fail()) {
+        spdlog::error("Failed to write trace file: {}", capture.path);
+        return;
+    }
+    spdlog::info("Wrote trace of {} frames to {}", capture.frames.size(), capture.path);
+}
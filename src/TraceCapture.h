@@ -0,0 +1,70 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+class StepGovernor;
+
+// Records a fixed number of frames and writes them as a Chrome Trace Event
+// JSON file (opens in chrome://tracing and ui.perfetto.dev). Captured data is
+// only copied on the main thread; serialization and file I/O run on a writer
+// thread so the frames being captured are not distorted by the export.
+class TraceCapture {
+public:
+    static constexpr int DEFAULT_FRAME_COUNT = 300;
+
+    TraceCapture() = default;
+    ~TraceCapture();
+
+    TraceCapture(const TraceCapture&) = delete;
+    auto operator=(const TraceCapture&) -> TraceCapture& = delete;
+
+    // Starts capturing the next frameCount frames; an empty path picks trace_<date>_<time>.json
+    void start(int frameCount, const std::string& path = "");
+    [[nodiscard]] auto isCapturing() const -> bool { return remainingFrames > 0; }
+
+    // Called once per frame after PROFILE_FRAME_MARK with the Box2D timings of that frame's step
+    // and, if there is one, the step governor after its update for the frame
+    void captureFrame(const b2Profile& physicsProfile, const StepGovernor* governor = nullptr);
+
+private:
+    struct Event {
+        const char* name;
+        uint64_t start; // Profiler ticks, or steady_clock nanoseconds without the profiler
+        uint64_t end;
+        uint32_t threadIndex;
+    };
+
+    struct PhysicsSample {
+        uint64_t timestamp;
+        b2Profile profile;
+    };
+
+    struct GovernorSample {
+        uint64_t timestamp;
+        int subStepCount;
+        int detailLevel;
+        const char* decision; // nullptr if nothing changed this frame
+    };
+
+    struct Capture {
+        std::string path;
+        double ticksPerMillisecond = 1e6;
+        uint64_t origin = 0;
+        std::vector<Event> frames;
+        std::vector<Event> zones;
+        std::vector<PhysicsSample> physics;
+        std::vector<GovernorSample> governor;
+    };
+
+    void finish();
+    static void write(const Capture& capture);
+
+    Capture capture;
+    int remainingFrames = 0;
+    uint64_t lastFrameEnd = 0;
+    std::thread writer;
+};
@@ -0,0 +1,63 @@
+#include "WorldSnapshot.h"
+
+void WorldSnapshot::capture(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters) {
+    this->tick = tick;
+    this->bodies.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        BodySnapshot& body = this->bodies[i];
+        body.transform = b2Body_GetTransform(bodies[i]);
+        body.linearVelocity = b2Body_GetLinearVelocity(bodies[i]);
+        body.angularVelocity = b2Body_GetAngularVelocity(bodies[i]);
+        body.awake = b2Body_IsAwake(bodies[i]);
+    }
+    this->characters.resize(characters.size());
+    for (size_t i = 0; i < characters.size(); ++i) {
+        characters[i]->saveState(this->characters[i]);
+    }
+}
+
+auto WorldSnapshot::restore(std::span<const b2BodyId> bodies, std::span<Character* const> characters) const -> bool {
+    if (bodies.size() != this->bodies.size() || characters.size() != this->characters.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const BodySnapshot& body = this->bodies[i];
+        b2Body_SetTransform(bodies[i], body.transform.p, body.transform.q);
+        b2Body_SetLinearVelocity(bodies[i], body.linearVelocity);
+        b2Body_SetAngularVelocity(bodies[i], body.angularVelocity);
+        // Last, since setting a velocity wakes the body
+        b2Body_SetAwake(bodies[i], body.awake);
+    }
+    for (size_t i = 0; i < characters.size(); ++i) {
+        characters[i]->restoreState(this->characters[i]);
+    }
+    return true;
+}
+
+void SnapshotHistory::capture(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters) {
+    snapshots.pushSlot().capture(tick, bodies, characters);
+}
+
+auto SnapshotHistory::rewindTo(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters) -> bool {
+    const size_t index = indexOf(tick);
+    if (index == snapshots.size() || !snapshots[index].restore(bodies, characters)) {
+        return false;
+    }
+    snapshots.truncateBack(index + 1);
+    return true;
+}
+
+auto SnapshotHistory::find(uint64_t tick) const -> const WorldSnapshot* {
+    const size_t index = indexOf(tick);
+    return index == snapshots.size() ? nullptr : &snapshots[index];
+}
+
+auto SnapshotHistory::indexOf(uint64_t tick) const -> size_t {
+    // Rewinds usually target recent ticks, so search from the newest
+    for (size_t i = snapshots.size(); i > 0; --i) {
+        if (snapshots[i - 1].tick == tick) {
+            return i - 1;
+        }
+    }
+    return snapshots.size();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Character.h"
+#include "RingBuffer.h"
+
+struct BodySnapshot {
+    b2Transform transform{};
+    b2Vec2 linearVelocity{};
+    float angularVelocity = 0.0f;
+    bool awake = false;
+};
+
+// Simulation state at the end of one tick: every tracked body and character,
+// in the order they were passed in. Restoring needs the same bodies in the same
+// order. Box2D's contact cache is not part of it, so stacked bodies can settle
+// slightly differently when a rewound tick is simulated again.
+struct WorldSnapshot {
+    uint64_t tick = 0;
+    std::vector<BodySnapshot> bodies;
+    std::vector<CharacterSnapshot> characters;
+
+    // Reuses the vectors' storage, so capturing into an old snapshot does not allocate
+    void capture(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters);
+    // False, changing nothing, if the bodies or characters differ in number from the capture
+    auto restore(std::span<const b2BodyId> bodies, std::span<Character* const> characters) const -> bool;
+};
+
+// The last CAPACITY ticks of snapshots, for rewinding while debugging and for
+// rollback. Slots are refilled in place once the ring has wrapped.
+class SnapshotHistory {
+public:
+    static constexpr size_t CAPACITY = 256; // About four seconds at 60 ticks per second
+
+    void capture(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters);
+    // Restores the snapshot of tick and forgets the ones after it; false if it is not in the ring
+    auto rewindTo(uint64_t tick, std::span<const b2BodyId> bodies, std::span<Character* const> characters) -> bool;
+    [[nodiscard]] auto find(uint64_t tick) const -> const WorldSnapshot*;
+    void clear() { snapshots.clear(); }
+
+    [[nodiscard]] auto size() const -> size_t { return snapshots.size(); }
+    [[nodiscard]] auto empty() const -> bool { return snapshots.empty(); }
+    // Precondition: !empty()
+    [[nodiscard]] auto oldestTick() const -> uint64_t { return snapshots.front().tick; }
+    [[nodiscard]] auto newestTick() const -> uint64_t { return snapshots.back().tick; }
+
+private:
+    [[nodiscard]] auto indexOf(uint64_t tick) const -> size_t;
+
+    RingBuffer<WorldSnapshot, CAPACITY> snapshots;
+};
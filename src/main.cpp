@@ -3,8 +3,7 @@
 #include <string>
 #include <cxxopts.hpp>
 #include <box2d/box2d.h>
-#include <fstream>
-#include <nlohmann/json.hpp>
+#include <filesystem>
 #include "Level.h"
 #include "Character.h"
 #include <spdlog/spdlog.h>
@@ -15,6 +14,26 @@
 #include "DeveloperMenu.h"
 #include "GameSettingsObserver.h"
 #include "Box2DDebugDraw.h"
+#include "RenderStats.h"
+#include "LowResRenderTarget.h"
+#include "Profiler.h"
+#include "TraceCapture.h"
+#include "FrameStats.h"
+#include "PhysicsStats.h"
+#include "AllocationTracker.h"
+#include "AssetCache.h"
+#include "AssetFileSystem.h"
+#include "ConfigReloader.h"
+#include "ControlServer.h"
+#include "GameConfig.h"
+#include "WorldSnapshot.h"
+#include "Determinism.h"
+#include "StepGovernor.h"
+#include "FramePacer.h"
+#include "InputBuffer.h"
+#include <array>
+#include <chrono>
+#include <fstream>
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
@@ -30,7 +49,13 @@ constexpr float FRAMES_PER_SECOND = 60.0F;
 constexpr float TIME_STEP = 1.0F / FRAMES_PER_SECOND;
 
 auto main(int argc, char *argv[]) -> int {
+    const auto startupStart = std::chrono::steady_clock::now();
+    AllocationTracker::installSdlAllocator();
     initializeLogging();
+    // Drain the async log queue on every return path
+    struct LoggingShutdown {
+        ~LoggingShutdown() { shutdownLogging(); }
+    } loggingShutdown;
     spdlog::info("Starting {} application", PROJECT_NAME);
 
     // Default window size
@@ -40,6 +65,18 @@ auto main(int argc, char *argv[]) -> int {
     bool developerMode = false;
     std::string assetDir = "assets"; // Default asset directory
     std::string levelName = "test_level"; // Default level name
+    std::string lowResolution; // Empty renders the world at window resolution
+    int traceFrames = 0; // Frames to capture into a trace file at startup
+    std::string logLevels; // Per-subsystem overrides, e.g. "level=trace,character=warn"
+    std::string packPath = "assets.pak"; // Loose files are used for anything the pack lacks
+    bool hotReload = false;
+    std::string controlSocket; // Empty disables the control channel
+    bool deterministic = false;
+    std::string tickHashPath; // Empty disables the per-tick state hashes
+    std::string pacing = "vsync";
+    std::string recordInputPath; // Empty disables input recording
+    std::string replayInputPath; // Empty plays live
+    float frameLimit = FRAMES_PER_SECOND; // The simulation advances one tick per frame, so faster frames speed the game up
 
     try {
         cxxopts::Options options(argv[0], "Platformer Prototype");
@@ -50,6 +87,18 @@ auto main(int argc, char *argv[]) -> int {
             ("a,assetDir", "Asset directory", cxxopts::value<std::string>(assetDir)->default_value("assets"))
             ("l,levelName", "Level name", cxxopts::value<std::string>(levelName)->default_value("test_level"))
             ("d,developerMode", "Developer mode", cxxopts::value<bool>(developerMode)->default_value("false"))
+            ("r,lowResolution", "Render the world at a fixed resolution (e.g. 480x270) and upscale it", cxxopts::value<std::string>(lowResolution))
+            ("t,trace-frames", "Capture N frames to a Chrome trace file (F3 captures at runtime)", cxxopts::value<int>(traceFrames))
+            ("p,pack", "Asset pack to mount; missing entries fall back to loose files", cxxopts::value<std::string>(packPath)->default_value("assets.pak"))
+            ("logLevels", "Per-subsystem log levels, e.g. level=trace,character=warn", cxxopts::value<std::string>(logLevels))
+            ("hotReload", "Apply edits to the configs, sprite sheets and level while running", cxxopts::value<bool>(hotReload)->default_value("false"))
+            ("controlSocket", "Accept local control clients (tools/ControlClient.cpp) on this Unix socket path", cxxopts::value<std::string>(controlSocket))
+            ("deterministic", "Single-threaded Box2D and a fixed sub-step count, so runs reproduce across builds", cxxopts::value<bool>(deterministic)->default_value("false"))
+            ("tickHashes", "Write a hash of the simulation state after every tick to this CSV file", cxxopts::value<std::string>(tickHashPath))
+            ("recordInput", "Write the input of every tick to this CSV file", cxxopts::value<std::string>(recordInputPath))
+            ("replayInput", "Play back input recorded with --recordInput instead of live input", cxxopts::value<std::string>(replayInputPath))
+            ("pacing", "Frame pacing: vsync, adaptive, uncapped or late-input", cxxopts::value<std::string>(pacing)->default_value("vsync"))
+            ("fpsLimit", "Frame rate limit in uncapped pacing; 0 disables it", cxxopts::value<float>(frameLimit)->default_value("60"))
             ("help", "Print help");
 
         auto result = options.parse(argc, argv);
@@ -58,34 +107,37 @@ auto main(int argc, char *argv[]) -> int {
             std::cout << options.help() << std::endl;
             return 0;
         }
+
+        if (!logLevels.empty() && !applyLogLevels(logLevels)) {
+            return 1;
+        }
     }
     catch (const cxxopts::exceptions::exception &e) {
         spdlog::error("Error parsing options: {}", e.what());
         return 1;
     }
 
-    // Load configuration file
-    std::ifstream configFile("config.json");
-    if (!configFile.is_open()) {
-        spdlog::error("Failed to open config.json");
-        return 1;
+    if (!packPath.empty() && std::filesystem::exists(packPath)) {
+        AssetFileSystem::mountPack(packPath);
+    } else {
+        spdlog::info("No asset pack at '{}', reading loose files", packPath);
     }
-    nlohmann::json config;
-    configFile >> config;
-    configFile.close();
 
-    float maxWalkingSpeed = config["maxWalkingSpeed"];
-    std::string preferredInputMethod = config["preferredInputMethod"];
+    // Typed configs, from the binary cache when the source files are unchanged
+    GameConfig gameConfig;
+    if (!ConfigLoader::load(gameConfig)) {
+        return 1;
+    }
+    float maxWalkingSpeed = gameConfig.app.maxWalkingSpeed;
 
-    // Load character configuration file
-    std::ifstream characterConfigFile("character_config.json");
-    if (!characterConfigFile.is_open()) {
-        spdlog::error("Failed to open character_config.json");
+    // Live or replayed input, applied once per tick
+    InputBuffer inputBuffer;
+    if (!replayInputPath.empty() && !inputBuffer.loadReplay(replayInputPath)) {
         return 1;
     }
-    nlohmann::json characterConfig;
-    characterConfigFile >> characterConfig;
-    characterConfigFile.close();
+    if (!recordInputPath.empty()) {
+        inputBuffer.startRecording(recordInputPath);
+    }
 
     // Initialize SDL with video subsystem
     if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD)) {
@@ -111,17 +163,28 @@ auto main(int argc, char *argv[]) -> int {
 
     // Create SDL_Renderer with SDL_RENDERER_ACCELERATED and SDL_RENDERER_PRESENTVSYNC flags
     SDL_Renderer *renderer = SDL_CreateRenderer(window, nullptr);
-    SDL_SetRenderVSync(renderer, 1);
     if (renderer == nullptr) {
         spdlog::error("SDL_CreateRenderer Error: {}", SDL_GetError());
         SDL_DestroyWindow(window);
         SDL_Quit();
         return 1;
     }
+
+    // LateInput plans its wait around the display's refresh interval
+    const SDL_DisplayMode *displayMode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    const float refreshRate = displayMode != nullptr && displayMode->refresh_rate > 0.0F ? displayMode->refresh_rate : FRAMES_PER_SECOND;
+    FramePacer framePacer(renderer, refreshRate, frameLimit);
+    PacingMode pacingMode = PacingMode::VSync;
+    if (!FramePacer::parse(pacing, pacingMode)) {
+        spdlog::warn("Unknown pacing mode '{}', using vsync", pacing);
+    }
+    if (!framePacer.setMode(pacingMode)) {
+        framePacer.setMode(PacingMode::VSync);
+    }
     SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
     SDL_ShowWindow(window);
 
-    Box2DDebugDraw debugDraw(renderer, 1.0f);
+    Box2DDebugDraw debugDraw(renderer);
     b2DebugDraw myDraw = b2DefaultDebugDraw();
     myDraw.context = &debugDraw;
 
@@ -165,15 +228,39 @@ auto main(int argc, char *argv[]) -> int {
     // Initialize Box2D World
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = b2Vec2{GRAVITY_X, GRAVITY_Y};
+    if (deterministic) {
+        Determinism::configureWorld(worldDef);
+    }
     b2WorldId worldId = b2CreateWorld(&worldDef);
 
+    // Owns every tile texture and sprite sheet, so it must outlive the level and characters
+    AssetCache assets(renderer);
+
     // Create Level object
     constexpr uint32_t WORLD_HEIGHT = 24;
     Level level(renderer, worldId, assetDir, windowWidth, windowHeight, WORLD_HEIGHT);
 
+    // Optional fixed low-resolution world target
+    std::unique_ptr<LowResRenderTarget> lowResTarget;
+    if (!lowResolution.empty()) {
+        int targetWidth = 0;
+        int targetHeight = 0;
+        if (!LowResRenderTarget::parseResolution(lowResolution, targetWidth, targetHeight)) {
+            spdlog::error("Invalid low resolution '{}', expected WIDTHxHEIGHT", lowResolution);
+        } else {
+            lowResTarget = std::make_unique<LowResRenderTarget>(renderer, targetWidth, targetHeight);
+            if (lowResTarget->isValid()) {
+                level.setViewportSize(targetWidth, targetHeight);
+            } else {
+                lowResTarget.reset();
+            }
+        }
+    }
+
     // Load tilemap
     std::string levelPath = assetDir + "/levels/" + levelName + ".tmj";
-    if (!level.loadTilemap(levelPath)) {
+    Character::requestAssets(gameConfig.character, assets);
+    if (!level.loadTilemap(levelPath, assets)) {
         spdlog::error("Failed to load tilemap: {}", levelPath);
         level.handleErrors();
         SDL_DestroyRenderer(renderer);
@@ -183,8 +270,13 @@ auto main(int argc, char *argv[]) -> int {
     }
 
     // Create Character object
-    Character character(renderer, worldId, 15.0F, 20.0F, windowWidth, windowHeight, characterConfig);
+    Character character(renderer, worldId, 15.0F, 20.0F, windowWidth, windowHeight, gameConfig.character, assets);
     character.setMaxWalkingSpeed(maxWalkingSpeed);
+    character.setCollisionGrid(&level.getCollisionGrid());
+    assets.releaseSurfaces();
+
+    // Static level geometry never moves, so its debug outline is recorded once (and again on a level reload)
+    debugDraw.setStaticGeometry(level.getStaticOutlines());
 
     // Initialize ImGui
     ImGui::CreateContext();
@@ -193,55 +285,205 @@ auto main(int argc, char *argv[]) -> int {
     ImGui_ImplSDL3_InitForSDLRenderer(window, renderer);
     ImGui_ImplSDLRenderer3_Init(renderer);
 
-    // Initialize DeveloperMenu with initial settings from characterConfig
-    DeveloperMenu developerMenu(characterConfig);
+    // Initialize DeveloperMenu with the character's movement values and the saved menu settings
+    DeveloperMenu developerMenu(gameConfig.developerSettings);
+    // Registered with the menu, so it has to live as long as the game loop
+    GameSettingsObserver gameSettingsObserver(worldId, character);
 
-    // Notify all observers of the initial settings if developer mode is enabled
+    // Notify all observers of the initial settings if developer mode or the control socket is enabled
     if (developerMode) {
         developerMenu.init(window, renderer);
-
-        // Create and register GameSettingsObserver
-        GameSettingsObserver gameSettingsObserver(worldId, character);
+    }
+    if (developerMode || !controlSocket.empty()) {
         developerMenu.addObserver(&gameSettingsObserver);
-
         developerMenu.notifyAllObservers();
     }
 
+    spdlog::info("Startup took {:.1f} ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupStart).count());
+
     bool running = true;
     bool showDebugWindow = false;
-    constexpr int subStepCount = 8;
+    // Sub-steps follow the measured step cost; deterministic runs need a fixed count
+    StepGovernorConfig governorConfig = gameConfig.app.stepGovernor;
+    governorConfig.enabled = governorConfig.enabled && !deterministic;
+    StepGovernor stepGovernor(governorConfig, TIME_STEP * 1000.0F);
+
+    TraceCapture traceCapture;
+    traceCapture.start(traceFrames);
+
+    FrameStats frameStats(TIME_STEP * 1000.0F);
+    developerMenu.setFrameStats(&frameStats);
+
+    PhysicsStats physicsStats;
+    physicsStats.setSceneInfo(stepGovernor.getSubStepCount(), level.getStaticChainVertexCount());
+    developerMenu.setPhysicsStats(&physicsStats);
+    developerMenu.setStepGovernor(&stepGovernor);
+    developerMenu.setFramePacer(&framePacer);
+
+    std::unique_ptr<ConfigReloader> configReloader;
+    if (hotReload) {
+        configReloader = std::make_unique<ConfigReloader>(ConfigReloadPaths{ConfigLoader::APP_CONFIG_PATH, ConfigLoader::CHARACTER_CONFIG_PATH, levelPath}, gameConfig.app, gameConfig.character);
+    }
+
+    std::unique_ptr<ControlServer> controlServer;
+    if (!controlSocket.empty()) {
+        controlServer = std::make_unique<ControlServer>(controlSocket);
+    }
+
+    // Developer mode keeps the last few seconds of ticks: Backspace rewinds, F5/F9 save and load a checkpoint
+    const std::array<b2BodyId, 1> snapshotBodies = {character.getBodyId()};
+    const std::array<Character*, 1> snapshotCharacters = {&character};
+    SnapshotHistory snapshotHistory;
+    WorldSnapshot checkpoint;
+    bool rewindHeld = false;
+    uint64_t simulationTick = 0;
+    if (developerMode) {
+        snapshotHistory.capture(simulationTick, snapshotBodies, snapshotCharacters);
+        checkpoint.capture(simulationTick, snapshotBodies, snapshotCharacters);
+    }
+
+    std::ofstream tickHashLog;
+    WorldSnapshot hashedState;
+    if (!tickHashPath.empty()) {
+        tickHashLog.open(tickHashPath);
+        if (!tickHashLog.is_open()) {
+            spdlog::error("Failed to open tick hash log: {}", tickHashPath);
+        } else {
+            if (!deterministic) {
+                spdlog::warn("Tick hashes without --deterministic are only comparable between runs of the same build");
+            }
+            Determinism::writeCsvHeader(tickHashLog);
+        }
+    }
+
+    // Rebuilds the changed islands and the debug geometry derived from them
+    auto applyTilemap = [&](const TilemapData& map, const std::string& source) {
+        const size_t rebuilt = level.applyTilemap(map, assets);
+        spdlog::info("Rebuilt {} level islands from {}", rebuilt, source);
+        debugDraw.setStaticGeometry(level.getStaticOutlines());
+        physicsStats.setSceneInfo(stepGovernor.getSubStepCount(), level.getStaticChainVertexCount());
+    };
 
     while (running) {
+        {
+            PROFILE_ZONE("FramePacer::waitForInput");
+            framePacer.waitForInput();
+        }
+
         // Handle events
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            ImGui_ImplSDL3_ProcessEvent(&event);
-            if (event.type == SDL_EVENT_QUIT) {
-                running = false;
-            }
-            // Handle other events (keyboard, mouse, etc.)
-            character.handleInput(event);
+        {
+            PROFILE_ZONE("SDL_PollEvent");
+            while (SDL_PollEvent(&event)) {
+                ImGui_ImplSDL3_ProcessEvent(&event);
+                framePacer.noteInput(event);
+                if (event.type == SDL_EVENT_QUIT) {
+                    running = false;
+                }
+                // Gameplay input waits in the buffer for the tick that samples it
+                inputBuffer.handleEvent(event);
 
-            if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F2) {
-                showDebugWindow = !showDebugWindow;
-                character.showDebugWindow(showDebugWindow);
-            }
+                if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F2) {
+                    showDebugWindow = !showDebugWindow;
+                    character.showDebugWindow(showDebugWindow);
+                }
 
-            if (developerMode) {
-                developerMenu.handleInput();
+                if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F3) {
+                    traceCapture.start(traceFrames > 0 ? traceFrames : TraceCapture::DEFAULT_FRAME_COUNT);
+                }
+
+                if (developerMode) {
+                    developerMenu.handleInput();
+
+                    if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F1) {
+                        developerMenu.toggleVisibility();
+                    }
+
+                    if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) && event.key.key == SDLK_BACKSPACE) {
+                        rewindHeld = event.type == SDL_EVENT_KEY_DOWN;
+                    }
+
+                    if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F5) {
+                        checkpoint.capture(simulationTick, snapshotBodies, snapshotCharacters);
+                    }
+
+                    if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F9 && checkpoint.restore(snapshotBodies, snapshotCharacters)) {
+                        simulationTick = checkpoint.tick;
+                        snapshotHistory.clear();
+                        snapshotHistory.capture(simulationTick, snapshotBodies, snapshotCharacters);
+                    }
+                }
+
+                if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE) {
+                    running = false;
+                }
+            }
+        }
 
-                if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F1) {
-                    developerMenu.toggleVisibility();
+        // Edits parsed by the reload thread; the menu is updated too so its sliders stay in sync
+        if (configReloader) {
+            for (ConfigReload& reload : configReloader->takeReloads()) {
+                PROFILE_ZONE("ConfigReload");
+                auto applyMovement = [&](const std::optional<float>& value, SettingId id, void (Character::*setter)(float)) {
+                    if (value) {
+                        (character.*setter)(*value);
+                        developerMenu.setSetting(id, *value);
+                    }
+                };
+                applyMovement(reload.maxWalkingSpeed, SettingId::MaxWalkingSpeed, &Character::setMaxWalkingSpeed);
+                applyMovement(reload.groundAcceleration, SettingId::GroundAcceleration, &Character::setGroundAcceleration);
+                applyMovement(reload.airAcceleration, SettingId::AirAcceleration, &Character::setAirAcceleration);
+                applyMovement(reload.jumpStrength, SettingId::JumpStrength, &Character::setJumpStrength);
+                if (reload.stepGovernor) {
+                    StepGovernorConfig config = *reload.stepGovernor;
+                    config.enabled = config.enabled && !deterministic;
+                    stepGovernor.setConfig(config);
+                }
+                character.setAnimations(reload.animations);
+                if (reload.tilemap) {
+                    applyTilemap(*reload.tilemap, reload.path);
                 }
             }
+        }
 
-            if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE) {
-                running = false;
+        // Scripted setting changes join this tick's batch; level reloads read the file from disk
+        if (controlServer && controlServer->poll(developerMenu)) {
+            PROFILE_ZONE("ControlServer reload");
+            std::string contents;
+            TilemapData map;
+            std::string error = "file could not be read";
+            const bool loaded = AssetFileSystem::readLooseText(levelPath, contents) && Level::parseTilemap(contents, map, error);
+            if (loaded) {
+                applyTilemap(map, levelPath);
+            } else {
+                spdlog::warn("Control client reload of {} failed: {}", levelPath, error);
             }
+            controlServer->finishLevelReload(loaded, error);
+        }
+
+        // Apply developer setting changes from the previous frame as one batch
+        developerMenu.dispatchSettingChanges();
+
+        // While rewinding, each frame steps back one tick instead of simulating
+        const bool rewinding = rewindHeld && snapshotHistory.size() > 1;
+        if (rewinding) {
+            PROFILE_ZONE("SnapshotHistory::rewindTo");
+            snapshotHistory.rewindTo(snapshotHistory.newestTick() - 1, snapshotBodies, snapshotCharacters);
+            simulationTick = snapshotHistory.newestTick();
         }
 
         // Update physics
-        b2World_Step(worldId, TIME_STEP, subStepCount);
+        if (!rewinding) {
+            // Jumps start before the step so they move the body this tick; sampling is input work, not simulation
+            character.applyInput(inputBuffer.sampleTick(simulationTick, SDL_GetTicksNS()));
+
+            PROFILE_ZONE("b2World_Step");
+            frameStats.beginSimTick();
+            character.prepareStep(TIME_STEP);
+            b2World_Step(worldId, TIME_STEP, stepGovernor.getSubStepCount());
+            frameStats.endSimTick();
+            physicsStats.record(worldId);
+        }
 
         // Start the ImGui frame
         ImGui_ImplSDLRenderer3_NewFrame();
@@ -249,54 +491,136 @@ auto main(int argc, char *argv[]) -> int {
         ImGui::NewFrame();
 
         // Update character
-        character.checkGroundContact();
-        character.update(TIME_STEP);
+        if (!rewinding) {
+            PROFILE_ZONE("Character::update");
+            frameStats.beginSimTick();
+            character.checkGroundContact();
+            character.update(TIME_STEP);
+            frameStats.endSimTick();
+            simulationTick++;
+        }
+
+        if (developerMode && !rewinding) {
+            PROFILE_ZONE("SnapshotHistory::capture");
+            snapshotHistory.capture(simulationTick, snapshotBodies, snapshotCharacters);
+        }
+
+        if (tickHashLog.is_open() && !rewinding) {
+            hashedState.capture(simulationTick, snapshotBodies, snapshotCharacters);
+            Determinism::writeCsvRow(tickHashLog, simulationTick, Determinism::hash(hashedState));
+        }
+
+        // One sample per simulated tick; rewinding steps nothing
+        if (controlServer && controlServer->hasSubscribers() && !rewinding) {
+            const b2Vec2 position = b2Body_GetPosition(character.getBodyId());
+            const b2Vec2 velocity = b2Body_GetLinearVelocity(character.getBodyId());
+            const TimingHistogram& frameTimes = frameStats.getFrameTimes();
+            const TimingHistogram& simTimes = frameStats.getSimTimes();
+            TelemetrySample sample;
+            sample.tick = simulationTick;
+            sample.x = position.x;
+            sample.y = position.y;
+            sample.velocityX = velocity.x;
+            sample.velocityY = velocity.y;
+            sample.grounded = character.isGrounded();
+            sample.frameMs = frameTimes.getSampleCount() > 0 ? frameTimes.getSample(0) : 0.0f;
+            sample.simMs = simTimes.getSampleCount() > 0 ? simTimes.getSample(0) : 0.0f;
+            controlServer->publishTelemetry(sample);
+        }
 
         // Game logic and rendering
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, COLOR_ALPHA); // Clear with black color
-        SDL_RenderClear(renderer);
+        RenderStats::reset();
+        // The low-res target clears its texture here and the window when it is drawn
+        if (lowResTarget) {
+            lowResTarget->begin();
+        } else {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, COLOR_ALPHA); // Clear with black color
+            SDL_RenderClear(renderer);
+        }
 
         // Render level
-        level.render();
-
-        debugDraw.setScale(level.getScale());
-        debugDraw.setOffset(level.getOffsetX(), level.getOffsetY());
-        debugDraw.setWindowSize(windowWidth, windowHeight);
-
-        if (developerMenu.isBox2DDebugDrawEnabled()) {
-            myDraw.drawShapes = developerMenu.shouldDrawShapes();
-            myDraw.drawJoints = developerMenu.shouldDrawJoints();
-            myDraw.drawAABBs = developerMenu.shouldDrawAABBs();
-            myDraw.drawContacts = developerMenu.shouldDrawContactPoints();
-            myDraw.drawContactNormals = developerMenu.shouldDrawContactNormals();
-            myDraw.drawContactImpulses = developerMenu.shouldDrawContactImpulses();
-            myDraw.drawFrictionImpulses = developerMenu.shouldDrawFrictionImpulses();
+        const CameraTransform camera = level.getCamera();
+        {
+            PROFILE_ZONE("Level::render");
+            level.render();
+        }
+
+        debugDraw.setCamera(camera);
+
+        // The governor drops debug draw detail first when frames run late
+        const DetailLevel detail = stepGovernor.getDetailLevel();
+        if (developerMenu.isBox2DDebugDrawEnabled() && detail != DetailLevel::Minimal) {
+            PROFILE_ZONE("b2World_Draw");
+            // With cached static outlines, the shape pass is replaced by drawStaticGeometry plus drawMovingBodies
+            myDraw.drawShapes = developerMenu.shouldDrawShapes() && !debugDraw.hasStaticGeometry();
+            const bool fullDetail = detail == DetailLevel::Full;
+            myDraw.drawJoints = fullDetail && developerMenu.shouldDrawJoints();
+            myDraw.drawAABBs = fullDetail && developerMenu.shouldDrawAABBs();
+            myDraw.drawContacts = fullDetail && developerMenu.shouldDrawContactPoints();
+            myDraw.drawContactNormals = fullDetail && developerMenu.shouldDrawContactNormals();
+            myDraw.drawContactImpulses = fullDetail && developerMenu.shouldDrawContactImpulses();
+            myDraw.drawFrictionImpulses = fullDetail && developerMenu.shouldDrawFrictionImpulses();
+            myDraw.drawingBounds = debugDraw.getVisibleBounds();
+            myDraw.useDrawingBounds = true;
             b2World_Draw(worldId, &myDraw);
+            if (developerMenu.shouldDrawShapes() && debugDraw.hasStaticGeometry()) {
+                debugDraw.drawStaticGeometry();
+                debugDraw.drawMovingBodies(worldId);
+            }
+            debugDraw.flush();
         }
 
         // Render character
-        character.render(level.getScale(), level.getOffsetX(), level.getOffsetY(), windowWidth, windowHeight);
+        {
+            PROFILE_ZONE("Character::render");
+            character.render(camera);
+        }
+
+        if (lowResTarget) {
+            lowResTarget->end();
+        }
 
         // Reset SDL renderer transformations before rendering ImGui
         SDL_SetRenderScale(renderer, displayScale, displayScale);
         SDL_SetRenderViewport(renderer, nullptr);
 
-        // Render developer menu if in developer mode
-        if (developerMode) {
-            developerMenu.render();
-        }
+        // Render developer menu and ImGui
+        {
+            PROFILE_ZONE("ImGui");
+            if (developerMode) {
+                developerMenu.render();
+            }
 
-        // Render ImGui
-        ImGui::Render();
-        ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), renderer);
+            ImGui::Render();
+            ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), renderer);
+        }
 
         // Reset SDL renderer scale to 1.0 for next frame
         SDL_SetRenderScale(renderer, 1.0f, 1.0f);
 
-        SDL_RenderPresent(renderer);
+        {
+            PROFILE_ZONE("SDL_RenderPresent");
+            framePacer.beginPresent();
+            SDL_RenderPresent(renderer);
+            framePacer.endPresent();
+        }
+
+        PROFILE_FRAME_MARK();
+        frameStats.endFrame();
+        // A rewound frame did not step, so the profile still holds the last real step
+        if (!rewinding) {
+            const int previousSubSteps = stepGovernor.getSubStepCount();
+            stepGovernor.update(b2World_GetProfile(worldId).step, frameStats.getFrameTimes().getSample(0));
+            if (stepGovernor.getSubStepCount() != previousSubSteps) {
+                physicsStats.setSceneInfo(stepGovernor.getSubStepCount(), level.getStaticChainVertexCount());
+            }
+        }
+        traceCapture.captureFrame(b2World_GetProfile(worldId), &stepGovernor);
     }
     spdlog::info("Exiting main game loop");
 
+    frameStats.writeCsv("logs/frame_stats.csv");
+
     // Save developer menu settings
     developerMenu.saveSettings();
 
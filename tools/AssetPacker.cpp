@@ -0,0 +1,226 @@
+#include <cxxopts.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AssetPack.h"
+#include "Lz4.h"
+
+// Builds an asset pack (see AssetPack.h) from files and directories given
+// relative to --root. Pack keys are the relative paths the game already uses,
+// e.g. "config.json" or "assets/tiles/ground.png".
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t MIN_COMPRESS_SIZE = 64;
+constexpr double MIN_COMPRESSION_GAIN = 0.1; // Store raw unless LZ4 saves at least 10%
+
+struct PackedFile {
+    std::string key;
+    std::vector<uint8_t> contents;
+    std::vector<uint8_t> compressed; // Empty when stored raw
+};
+
+auto readFile(const fs::path& path, std::vector<uint8_t>& out) -> bool {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+auto collectFiles(const fs::path& root, const std::vector<std::string>& inputs, const std::set<std::string>& excluded,
+                  std::map<std::string, fs::path>& files) -> bool {
+    auto add = [&](const fs::path& file) -> bool {
+        std::string extension = file.extension().string();
+        if (!extension.empty() && excluded.count(extension.substr(1)) != 0) {
+            return true;
+        }
+        fs::path key = file.lexically_normal().lexically_relative(root.lexically_normal());
+        if (key.empty() || *key.begin() == "..") {
+            spdlog::error("{} is outside the pack root {}", file.string(), root.string());
+            return false;
+        }
+        files.emplace(key.generic_string(), file);
+        return true;
+    };
+
+    for (const std::string& input : inputs) {
+        fs::path path = root / input;
+        std::error_code error;
+        if (fs::is_directory(path, error)) {
+            for (const auto& item : fs::recursive_directory_iterator(path, error)) {
+                if (item.is_regular_file() && !add(item.path())) {
+                    return false;
+                }
+            }
+        } else if (fs::is_regular_file(path, error)) {
+            if (!add(path)) {
+                return false;
+            }
+        } else {
+            spdlog::error("Input {} does not exist", path.string());
+            return false;
+        }
+    }
+    return true;
+}
+
+auto writePack(const std::string& outputPath, std::vector<PackedFile>& files) -> bool {
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+        return AssetPack::hashPath(a.key) < AssetPack::hashPath(b.key);
+    });
+
+    std::string stringTable;
+    std::vector<AssetPackEntry> entries(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        AssetPackEntry& entry = entries[i];
+        entry.pathHash = AssetPack::hashPath(files[i].key);
+        entry.pathOffset = static_cast<uint32_t>(stringTable.size());
+        entry.pathLength = static_cast<uint32_t>(files[i].key.size());
+        entry.size = static_cast<uint32_t>(files[i].contents.size());
+        entry.flags = files[i].compressed.empty() ? 0 : AssetPack::FLAG_LZ4;
+        entry.storedSize = static_cast<uint32_t>(files[i].compressed.empty() ? files[i].contents.size() : files[i].compressed.size());
+        stringTable += files[i].key;
+    }
+
+    auto align = [](uint64_t offset) { return (offset + AssetPack::ALIGNMENT - 1) & ~(AssetPack::ALIGNMENT - 1); };
+    uint64_t offset = align(sizeof(AssetPackHeader) + (entries.size() * sizeof(AssetPackEntry)) + stringTable.size());
+    for (AssetPackEntry& entry : entries) {
+        entry.dataOffset = offset;
+        offset = align(offset + entry.storedSize);
+    }
+
+    AssetPackHeader header{};
+    std::memcpy(header.magic, AssetPack::MAGIC, sizeof(header.magic));
+    header.version = AssetPack::VERSION;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        spdlog::error("Failed to open {} for writing", outputPath);
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPackEntry)));
+    out.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+    for (size_t i = 0; i < files.size(); ++i) {
+        const std::vector<uint8_t>& stored = files[i].compressed.empty() ? files[i].contents : files[i].compressed;
+        const std::string padding(entries[i].dataOffset - static_cast<uint64_t>(out.tellp()), '\0');
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+    }
+    return out.good();
+}
+
+// Reads the pack back through the runtime reader
+auto verifyPack(const std::string& outputPath, const std::vector<PackedFile>& files) -> bool {
+    AssetPack pack;
+    if (!pack.open(outputPath) || pack.getEntries().size() != files.size()) {
+        return false;
+    }
+    for (const PackedFile& file : files) {
+        const AssetPackEntry* entry = pack.find(file.key);
+        if (entry == nullptr || entry->size != file.contents.size()) {
+            spdlog::error("Entry {} is missing from the written pack", file.key);
+            return false;
+        }
+        std::vector<uint8_t> contents(pack.getStoredData(*entry), pack.getStoredData(*entry) + entry->storedSize);
+        if ((entry->flags & AssetPack::FLAG_LZ4) != 0) {
+            std::vector<uint8_t> compressed = std::move(contents);
+            contents.assign(entry->size, 0);
+            if (!Lz4::decompress(compressed.data(), compressed.size(), contents.data(), contents.size())) {
+                contents.clear();
+            }
+        }
+        if (contents != file.contents) {
+            spdlog::error("Entry {} does not round-trip", file.key);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    std::string outputPath = "assets.pak";
+    std::string root = ".";
+    std::string excludedList;
+    bool noCompression = false;
+    std::vector<std::string> inputs;
+
+    try {
+        cxxopts::Options options(argv[0], "Asset pack builder");
+        options.add_options()
+            ("o,output", "Pack file to write", cxxopts::value<std::string>(outputPath)->default_value("assets.pak"))
+            ("root", "Directory the pack keys are relative to", cxxopts::value<std::string>(root)->default_value("."))
+            ("exclude", "Comma-separated file extensions to skip", cxxopts::value<std::string>(excludedList)->default_value("xcf,tsx,tmx"))
+            ("no-compression", "Store every entry uncompressed", cxxopts::value<bool>(noCompression)->default_value("false"))
+            ("inputs", "Files and directories to pack", cxxopts::value<std::vector<std::string>>(inputs))
+            ("help", "Print help");
+        options.parse_positional({"inputs"});
+        options.positional_help("FILE_OR_DIR...");
+
+        auto result = options.parse(argc, argv);
+        if (result.count("help") != 0U || inputs.empty()) {
+            std::cout << options.help() << std::endl;
+            return inputs.empty() && result.count("help") == 0U ? 1 : 0;
+        }
+    }
+    catch (const cxxopts::exceptions::exception& e) {
+        spdlog::error("Error parsing options: {}", e.what());
+        return 1;
+    }
+
+    std::set<std::string> excluded;
+    std::stringstream extensions(excludedList);
+    for (std::string extension; std::getline(extensions, extension, ',');) {
+        excluded.insert(extension);
+    }
+
+    std::map<std::string, fs::path> paths;
+    if (!collectFiles(root, inputs, excluded, paths)) {
+        return 1;
+    }
+
+    std::vector<PackedFile> files;
+    files.reserve(paths.size());
+    uint64_t rawBytes = 0;
+    uint64_t storedBytes = 0;
+    for (const auto& [key, path] : paths) {
+        PackedFile file{key, {}, {}};
+        if (!readFile(path, file.contents)) {
+            spdlog::error("Failed to read {}", path.string());
+            return 1;
+        }
+        if (!noCompression && file.contents.size() >= MIN_COMPRESS_SIZE) {
+            std::vector<uint8_t> compressed = Lz4::compress(file.contents.data(), file.contents.size());
+            if (static_cast<double>(compressed.size()) <= static_cast<double>(file.contents.size()) * (1.0 - MIN_COMPRESSION_GAIN)) {
+                file.compressed = std::move(compressed);
+            }
+        }
+        rawBytes += file.contents.size();
+        storedBytes += file.compressed.empty() ? file.contents.size() : file.compressed.size();
+        files.push_back(std::move(file));
+    }
+
+    if (!writePack(outputPath, files) || !verifyPack(outputPath, files)) {
+        spdlog::error("Failed to write {}", outputPath);
+        return 1;
+    }
+    spdlog::info("Packed {} files into {} ({} bytes, {} after compression)", files.size(), outputPath, rawBytes, storedBytes);
+    return 0;
+}
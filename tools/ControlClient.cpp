@@ -0,0 +1,206 @@
+#include <cxxopts.hpp>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "ControlProtocol.h"
+
+// Command-line client for the game's control socket (--controlSocket), e.g.
+//   control_client list
+//   control_client set jumpStrength 12
+//   control_client -- set gravity -15     (negative values need the --)
+//   control_client reload
+//   control_client telemetry --count 600 > run.csv
+
+namespace {
+
+class Connection {
+public:
+    ~Connection() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    auto open(const std::string& path) -> bool {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Socket path is too long: " << path << '\n';
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            std::cerr << "Cannot connect to " << path << ": " << std::strerror(errno) << '\n';
+            return false;
+        }
+        return true;
+    }
+
+    auto send(ControlMessage type, const std::vector<uint8_t>& payload = {}) -> bool {
+        std::vector<uint8_t> bytes;
+        ControlProtocol::appendFrame(bytes, type, payload);
+        for (size_t written = 0; written < bytes.size();) {
+            const ssize_t sent = ::send(fd, bytes.data() + written, bytes.size() - written, 0);
+            if (sent <= 0 && errno != EINTR) {
+                std::cerr << "Send failed: " << std::strerror(errno) << '\n';
+                return false;
+            }
+            written += sent > 0 ? static_cast<size_t>(sent) : 0;
+        }
+        return true;
+    }
+
+    // Blocks until a whole frame has arrived
+    auto receive(ControlFrame& frame) -> bool {
+        std::array<uint8_t, 4096> chunk{};
+        while (!ControlProtocol::takeFrame(buffer, frame)) {
+            const ssize_t received = recv(fd, chunk.data(), chunk.size(), 0);
+            if (received <= 0) {
+                if (received < 0 && errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Connection closed by the game\n";
+                return false;
+            }
+            buffer.insert(buffer.end(), chunk.begin(), chunk.begin() + received);
+        }
+        return true;
+    }
+
+private:
+    int fd = -1;
+    std::vector<uint8_t> buffer;
+};
+
+auto parseValue(const std::string& text) -> ControlValue {
+    if (text == "true" || text == "false") {
+        return text == "true";
+    }
+    return std::stof(text); // The game converts it to the setting's own type
+}
+
+void printValue(const ControlValue& value) {
+    std::visit([](auto typed) {
+        if constexpr (std::is_same_v<decltype(typed), bool>) {
+            std::cout << (typed ? "true" : "false");
+        } else {
+            std::cout << typed;
+        }
+    }, value);
+}
+
+// Prints Setting replies until Ok (or after the first one for get/set); false on Error
+auto printReplies(Connection& connection, bool singleSetting = false) -> bool {
+    ControlFrame frame;
+    while (connection.receive(frame)) {
+        ControlPayloadReader reader(frame.payload);
+        if (frame.type == ControlMessage::Setting) {
+            const std::string key = reader.readString();
+            const ControlValue value = reader.readValue();
+            std::cout << key << " = ";
+            printValue(value);
+            std::cout << '\n';
+            if (singleSetting) {
+                return true;
+            }
+        } else if (frame.type == ControlMessage::Error) {
+            std::cerr << "Error: " << reader.readString() << '\n';
+            return false;
+        }
+        if (frame.type == ControlMessage::Ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto streamTelemetry(Connection& connection, uint64_t count) -> bool {
+    ControlPayloadWriter subscribe;
+    subscribe.writeU8(1);
+    if (!connection.send(ControlMessage::Subscribe, subscribe.bytes)) {
+        return false;
+    }
+    std::cout << "tick,x,y,velocityX,velocityY,grounded,frameMs,simMs\n";
+    ControlFrame frame;
+    for (uint64_t received = 0; count == 0 || received < count;) {
+        if (!connection.receive(frame)) {
+            return false;
+        }
+        if (frame.type != ControlMessage::Telemetry) {
+            continue;
+        }
+        ControlPayloadReader reader(frame.payload);
+        const TelemetrySample sample = reader.readTelemetry();
+        std::cout << sample.tick << ',' << sample.x << ',' << sample.y << ',' << sample.velocityX << ',' << sample.velocityY << ','
+                  << (sample.grounded ? 1 : 0) << ',' << sample.frameMs << ',' << sample.simMs << '\n';
+        ++received;
+    }
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    std::string socketPath = "platformer.sock";
+    uint64_t count = 0;
+    std::vector<std::string> command;
+
+    cxxopts::Options options(argv[0], "Control a running game through its control socket");
+    options.add_options()
+        ("s,socket", "Control socket path", cxxopts::value<std::string>(socketPath)->default_value("platformer.sock"))
+        ("n,count", "Telemetry samples to print; 0 streams until interrupted", cxxopts::value<uint64_t>(count)->default_value("0"))
+        ("command", "list | get KEY | set KEY VALUE | reload | telemetry", cxxopts::value<std::vector<std::string>>(command))
+        ("help", "Print help");
+    options.parse_positional({"command"});
+    options.positional_help("COMMAND [ARGS...]");
+
+    try {
+        auto result = options.parse(argc, argv);
+        if (result.count("help") != 0U || command.empty()) {
+            std::cout << options.help() << std::endl;
+            return command.empty() && result.count("help") == 0U ? 1 : 0;
+        }
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error parsing options: " << e.what() << '\n';
+        return 1;
+    }
+
+    Connection connection;
+    if (!connection.open(socketPath)) {
+        return 1;
+    }
+
+    const std::string& verb = command[0];
+    ControlPayloadWriter payload;
+    bool succeeded = false;
+    try {
+        if (verb == "list" && command.size() == 1) {
+            succeeded = connection.send(ControlMessage::ListSettings) && printReplies(connection);
+        } else if (verb == "get" && command.size() == 2) {
+            payload.writeString(command[1]);
+            succeeded = connection.send(ControlMessage::GetSetting, payload.bytes) && printReplies(connection, true);
+        } else if (verb == "set" && command.size() == 3) {
+            payload.writeString(command[1]);
+            payload.writeValue(parseValue(command[2]));
+            succeeded = connection.send(ControlMessage::SetSetting, payload.bytes) && printReplies(connection, true);
+        } else if (verb == "reload" && command.size() == 1) {
+            succeeded = connection.send(ControlMessage::ReloadLevel) && printReplies(connection);
+        } else if (verb == "telemetry" && command.size() == 1) {
+            succeeded = streamTelemetry(connection, count);
+        } else {
+            std::cerr << "Unknown command\n" << options.help() << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid value '" << command.back() << "': " << e.what() << '\n';
+    }
+    return succeeded ? 0 : 1;
+}